@@ -0,0 +1,113 @@
+// Factorize.h
+// Integer factorization for the full uint64_t range:
+// trial division by small primes, then Pollard-Brent rho on what remains,
+// with deterministic Miller-Rabin deciding when a factor is prime.
+
+#ifndef FACTORIZE_H
+#define FACTORIZE_H
+
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "MillerRabin.h"
+
+// Binary GCD: shifts and subtractions only
+inline uint64_t binary_gcd(uint64_t a, uint64_t b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    int shift = __builtin_ctzll(a | b);
+    a >>= __builtin_ctzll(a);
+    while (b) {
+        b >>= __builtin_ctzll(b);
+        if (a > b) std::swap(a, b);
+        b -= a;
+    }
+    return a << shift;
+}
+
+// Pollard-Brent rho for an odd composite n with x -> x^2 + c, in Montgomery form.
+// The |x - y| of up to 128 steps are multiplied together so that one GCD covers
+// the whole batch; if the batch overshoots (GCD == n) the last batch is replayed
+// step by step. Returns a divisor of n, which is n itself if this c failed.
+inline uint64_t pollard_brent(uint64_t n, uint64_t c) {
+    const uint64_t batch = 128;
+    Montgomery mont(n);
+    uint64_t cm = mont.to_mont(c % n);
+    auto f = [&](uint64_t x) {
+        uint64_t r = mont.mul(x, x) + cm;
+        return (r < cm || r >= n) ? r - n : r; // modular add without overflow
+    };
+    auto diff = [](uint64_t a, uint64_t b) { return a > b ? a - b : b - a; };
+
+    uint64_t y = mont.to_mont(2), x = y, ys = y;
+    uint64_t q = mont.one(), g = 1;
+    for (uint64_t r = 1; g == 1; r *= 2) {
+        x = y;
+        for (uint64_t i = 0; i < r; ++i) y = f(y);
+        for (uint64_t k = 0; k < r && g == 1; k += batch) {
+            ys = y;
+            for (uint64_t i = 0; i < batch && i < r - k; ++i) {
+                y = f(y);
+                q = mont.mul(q, diff(x, y));
+            }
+            g = binary_gcd(q, n);
+        }
+    }
+    if (g == n) {
+        do {
+            ys = f(ys);
+            g = binary_gcd(diff(x, ys), n);
+        } while (g == 1);
+    }
+    return g;
+}
+
+// Appends the prime factors of n (> 1, no factor below 100) to factors, with repetition
+inline void factorize_rho(uint64_t n, std::vector<uint64_t>& factors) {
+    if (n == 1) return;
+    if (isPrime_miller_rabin(n)) {
+        factors.push_back(n);
+        return;
+    }
+    uint64_t d = n;
+    for (uint64_t c = 1; d == n; ++c) d = pollard_brent(n, c);
+    factorize_rho(d, factors);
+    factorize_rho(n / d, factors);
+}
+
+// Prime factorization of n as (prime, multiplicity) pairs in increasing order.
+// factorize(0) and factorize(1) are empty.
+inline std::vector<std::pair<uint64_t, int>> factorize(uint64_t n) {
+    static const uint32_t small_primes[] = {
+        2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47,
+        53, 59, 61, 67, 71, 73, 79, 83, 89, 97
+    };
+
+    std::vector<std::pair<uint64_t, int>> result;
+    if (n == 0) return result;
+
+    for (uint32_t p : small_primes) {
+        if (n % p != 0) continue;
+        int k = 0;
+        while (n % p == 0) {
+            n /= p;
+            ++k;
+        }
+        result.push_back(std::make_pair(uint64_t(p), k));
+    }
+
+    std::vector<uint64_t> factors;
+    factorize_rho(n, factors);
+    std::sort(factors.begin(), factors.end());
+    for (uint64_t p : factors) {
+        if (!result.empty() && result.back().first == p) {
+            result.back().second++;
+        } else {
+            result.push_back(std::make_pair(p, 1));
+        }
+    }
+    return result;
+}
+
+#endif // FACTORIZE_H
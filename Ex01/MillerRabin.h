@@ -0,0 +1,114 @@
+// MillerRabin.h
+// Deterministic Miller-Rabin primality test for the full uint64_t range.
+
+#ifndef MILLER_RABIN_H
+#define MILLER_RABIN_H
+
+#include <cstdint>
+
+// Montgomery arithmetic modulo an odd 64-bit modulus n (R = 2^64).
+// Replaces the 128-bit division of (a * b) % n by two multiplications.
+class Montgomery {
+public:
+    explicit Montgomery(uint64_t n) : _n(n), _inv(inverse(n)) {
+        uint64_t r1 = (0 - n) % n;                              // 2^64 mod n
+        _r2 = (uint64_t)((unsigned __int128)r1 * r1 % n);       // 2^128 mod n
+        _one = r1;
+    }
+
+    uint64_t modulus() const { return _n; }
+
+    // Montgomery form of 1 (R mod n)
+    uint64_t one() const { return _one; }
+
+    // Convert a (< n) into and out of Montgomery form
+    uint64_t to_mont(uint64_t a) const { return reduce((unsigned __int128)a * _r2); }
+    uint64_t from_mont(uint64_t a) const { return reduce(a); }
+
+    // Product of two values in Montgomery form
+    uint64_t mul(uint64_t a, uint64_t b) const { return reduce((unsigned __int128)a * b); }
+
+    // base^e for base in Montgomery form (result in Montgomery form)
+    uint64_t pow(uint64_t base, uint64_t e) const {
+        uint64_t result = _one;
+        while (e) {
+            if (e & 1) result = mul(result, base);
+            base = mul(base, base);
+            e >>= 1;
+        }
+        return result;
+    }
+
+private:
+    uint64_t _n;    // odd modulus
+    uint64_t _inv;  // n^-1 mod 2^64
+    uint64_t _r2;   // R^2 mod n
+    uint64_t _one;  // R mod n
+
+    // Newton iteration: each step doubles the number of correct low bits
+    static uint64_t inverse(uint64_t n) {
+        uint64_t x = n; // correct to 3 bits for any odd n
+        for (int i = 0; i < 5; ++i) x *= 2 - n * x;
+        return x;
+    }
+
+    // Returns t * R^-1 mod n for t < n * 2^64. Written as hi(t) - hi(m * n)
+    // so that it never overflows, even when n is close to 2^64.
+    uint64_t reduce(unsigned __int128 t) const {
+        uint64_t m = (uint64_t)t * _inv;
+        uint64_t mn_hi = (uint64_t)(((unsigned __int128)m * _n) >> 64);
+        uint64_t t_hi = (uint64_t)(t >> 64);
+        uint64_t r = t_hi - mn_hi;
+        return t_hi < mn_hi ? r + _n : r;
+    }
+};
+
+// One Miller-Rabin round for odd n = d * 2^s + 1; false means n is composite
+inline bool miller_rabin_round(const Montgomery& mont, uint64_t a, uint64_t d, int s) {
+    uint64_t n = mont.modulus();
+    a %= n;
+    if (a == 0) return true; // the witness is a multiple of n: no information
+
+    uint64_t one = mont.one();
+    uint64_t minus_one = n - one; // Montgomery form of n - 1
+    uint64_t x = mont.pow(mont.to_mont(a), d);
+    if (x == one || x == minus_one) return true;
+
+    for (int r = 1; r < s; ++r) {
+        x = mont.mul(x, x);
+        if (x == minus_one) return true;
+        if (x == one) return false;
+    }
+    return false;
+}
+
+// Deterministic primality test for any 64-bit integer.
+// Small primes are filtered first by trial division, then Miller-Rabin runs
+// with the 7-base witness set of Jim Sinclair, which has no pseudoprime below 2^64.
+inline bool isPrime_miller_rabin(uint64_t n) {
+    static const uint32_t small_primes[] = {
+        2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47,
+        53, 59, 61, 67, 71, 73, 79, 83, 89, 97
+    };
+    static const uint64_t witnesses[] = {
+        2, 325, 9375, 28178, 450775, 9780504, 1795265022
+    };
+
+    if (n < 2) return false;
+    for (uint32_t p : small_primes) {
+        if (n % p == 0) return n == p;
+    }
+    if (n < 101 * 101) return true; // no prime factor <= 97 and n < 101^2
+
+    uint64_t d = n - 1;
+    int s = __builtin_ctzll(d);
+    d >>= s;
+
+    Montgomery mont(n);
+    for (uint64_t a : witnesses) {
+        if (!miller_rabin_round(mont, a, d, s)) return false;
+    }
+    return true;
+}
+
+#endif // MILLER_RABIN_H
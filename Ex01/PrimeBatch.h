@@ -0,0 +1,239 @@
+// PrimeBatch.h
+// Batched primality testing: is_prime_batch(in, out, n) sets out[i] = isPrime(in[i]).
+//
+// 1. Pre-filter: divisibility by the odd primes 3..97 is tested without any
+//    division, vectorized with AVX-512 (8 lanes) or AVX2 (4 lanes) when the
+//    compiler targets them (-mavx512dq / -mavx2 / -march=native), scalar otherwise.
+//    For odd p, n is a multiple of p iff n * p^-1 (mod 2^64) <= (2^64 - 1) / p.
+// 2. Survivors run Miller-Rabin BATCH_LANES at a time: the lanes' Montgomery
+//    products are independent, so interleaving them keeps the multiplier busy
+//    instead of waiting on one long dependency chain. A first pass with base 2
+//    removes almost every composite, so the remaining witnesses run on lanes
+//    that are nearly all primes and no lane idles in lockstep.
+
+#ifndef PRIME_BATCH_H
+#define PRIME_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MillerRabin.h"
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// Divisibility data for one odd prime p
+struct SmallPrimeDivisor {
+    uint64_t p;
+    uint64_t inverse; // p^-1 mod 2^64
+    uint64_t limit;   // (2^64 - 1) / p
+};
+
+constexpr uint64_t inverse_mod_2_64(uint64_t p) {
+    uint64_t x = p;
+    for (int i = 0; i < 5; ++i) x *= 2 - p * x;
+    return x;
+}
+
+constexpr SmallPrimeDivisor make_divisor(uint64_t p) {
+    return SmallPrimeDivisor{p, inverse_mod_2_64(p), UINT64_MAX / p};
+}
+
+constexpr SmallPrimeDivisor BATCH_DIVISORS[] = {
+    make_divisor(3),  make_divisor(5),  make_divisor(7),  make_divisor(11), make_divisor(13),
+    make_divisor(17), make_divisor(19), make_divisor(23), make_divisor(29), make_divisor(31),
+    make_divisor(37), make_divisor(41), make_divisor(43), make_divisor(47), make_divisor(53),
+    make_divisor(59), make_divisor(61), make_divisor(67), make_divisor(71), make_divisor(73),
+    make_divisor(79), make_divisor(83), make_divisor(89), make_divisor(97)
+};
+
+// Pre-filter outcome stored in out[] until Miller-Rabin has run
+const uint8_t BATCH_COMPOSITE = 0;
+const uint8_t BATCH_PRIME = 1;
+const uint8_t BATCH_UNDECIDED = 2;
+
+// Classifies one value given whether it has a small prime factor other than itself
+inline uint8_t batch_classify(uint64_t n, bool small_factor) {
+    if (n < 2 || small_factor) return BATCH_COMPOSITE;
+    if (n < 101 * 101) return BATCH_PRIME; // no factor <= 97 and below 101^2
+    return BATCH_UNDECIDED;
+}
+
+inline bool has_small_factor_scalar(uint64_t n) {
+    if ((n & 1) == 0) return n != 2;
+    bool factor = false;
+    for (const SmallPrimeDivisor& d : BATCH_DIVISORS) {
+        factor |= (n * d.inverse <= d.limit) & (n != d.p);
+    }
+    return factor;
+}
+
+// Writes BATCH_COMPOSITE / BATCH_PRIME / BATCH_UNDECIDED for every input
+inline void batch_prefilter(const uint64_t* in, uint8_t* out, size_t n) {
+    size_t i = 0;
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m512i two = _mm512_set1_epi64(2);
+    for (; i + 8 <= n; i += 8) {
+        __m512i x = _mm512_loadu_si512((const void*)(in + i));
+        // even and not 2
+        __mmask8 factor = _mm512_cmpeq_epi64_mask(_mm512_and_si512(x, one), _mm512_setzero_si512()) &
+                          _mm512_cmpneq_epi64_mask(x, two);
+        for (const SmallPrimeDivisor& d : BATCH_DIVISORS) {
+            __m512i q = _mm512_mullo_epi64(x, _mm512_set1_epi64((long long)d.inverse));
+            factor |= _mm512_cmple_epu64_mask(q, _mm512_set1_epi64((long long)d.limit)) &
+                      _mm512_cmpneq_epi64_mask(x, _mm512_set1_epi64((long long)d.p));
+        }
+        for (int l = 0; l < 8; ++l) out[i + l] = batch_classify(in[i + l], (factor >> l) & 1);
+    }
+#elif defined(__AVX2__)
+    // AVX2 has no 64-bit low multiply or unsigned compare: both are emulated
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i two = _mm256_set1_epi64x(2);
+    const __m256i sign = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    auto mullo64 = [](__m256i a, __m256i b) {
+        __m256i lo = _mm256_mul_epu32(a, b);
+        __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                         _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+        return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+    };
+    for (; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(in + i));
+        __m256i factor = _mm256_andnot_si256(_mm256_cmpeq_epi64(x, two),
+                                             _mm256_cmpeq_epi64(_mm256_and_si256(x, one), _mm256_setzero_si256()));
+        for (const SmallPrimeDivisor& d : BATCH_DIVISORS) {
+            __m256i q = mullo64(x, _mm256_set1_epi64x((long long)d.inverse));
+            // q <= limit  <=>  !(q > limit), compared as signed after flipping the sign bits
+            __m256i above = _mm256_cmpgt_epi64(_mm256_xor_si256(q, sign),
+                                               _mm256_set1_epi64x((long long)(d.limit ^ 0x8000000000000000ULL)));
+            __m256i is_p = _mm256_cmpeq_epi64(x, _mm256_set1_epi64x((long long)d.p));
+            factor = _mm256_or_si256(factor, _mm256_andnot_si256(_mm256_or_si256(above, is_p), _mm256_set1_epi64x(-1)));
+        }
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(factor));
+        for (int l = 0; l < 4; ++l) out[i + l] = batch_classify(in[i + l], (mask >> l) & 1);
+    }
+#endif
+    for (; i < n; ++i) out[i] = batch_classify(in[i], has_small_factor_scalar(in[i]));
+}
+
+// Number of Miller-Rabin problems interleaved at once
+const int BATCH_LANES = 4;
+
+// Miller-Rabin on BATCH_LANES odd moduli > 97 at once with the given witnesses;
+// writes 1 (probable prime for all witnesses) or 0 to result[]
+inline void miller_rabin_lanes(const uint64_t* n, uint8_t* result,
+                               const uint64_t* witnesses, int num_witnesses) {
+    const int L = BATCH_LANES;
+
+    const Montgomery mont[BATCH_LANES] = {
+        Montgomery(n[0]), Montgomery(n[1]), Montgomery(n[2]), Montgomery(n[3])
+    };
+    uint64_t d[L], minus_one[L];
+    int s[L];
+    bool alive[L];
+    uint64_t max_d = 0;
+    int max_s = 0;
+    for (int l = 0; l < L; ++l) {
+        s[l] = __builtin_ctzll(n[l] - 1);
+        d[l] = (n[l] - 1) >> s[l];
+        minus_one[l] = n[l] - mont[l].one();
+        alive[l] = true;
+        max_d |= d[l];
+        if (s[l] > max_s) max_s = s[l];
+    }
+
+    for (int w = 0; w < num_witnesses; ++w) {
+        uint64_t base[L], x[L];
+        bool pass[L];
+        for (int l = 0; l < L; ++l) {
+            uint64_t am = witnesses[w] % n[l];
+            pass[l] = !alive[l] || am == 0;
+            base[l] = mont[l].to_mont(am);
+            x[l] = mont[l].one();
+        }
+
+        // Right-to-left exponentiation, all lanes in lockstep; the selects compile to cmov
+        for (uint64_t bit = 1; bit && bit <= max_d; bit <<= 1) {
+            for (int l = 0; l < L; ++l) {
+                uint64_t prod = mont[l].mul(x[l], base[l]);
+                x[l] = (d[l] & bit) ? prod : x[l];
+                base[l] = mont[l].mul(base[l], base[l]);
+            }
+        }
+
+        for (int l = 0; l < L; ++l) pass[l] = pass[l] || x[l] == mont[l].one() || x[l] == minus_one[l];
+        for (int r = 1; r < max_s; ++r) {
+            for (int l = 0; l < L; ++l) {
+                if (pass[l] || r >= s[l]) continue;
+                x[l] = mont[l].mul(x[l], x[l]);
+                pass[l] = x[l] == minus_one[l];
+            }
+        }
+
+        bool any_alive = false;
+        for (int l = 0; l < L; ++l) {
+            alive[l] = alive[l] && pass[l];
+            any_alive |= alive[l];
+        }
+        if (!any_alive) break;
+    }
+    for (int l = 0; l < L; ++l) result[l] = alive[l] ? 1 : 0;
+}
+
+// Runs the witnesses over in[index[k]] for every k, BATCH_LANES at a time, and
+// compacts index[] to the candidates that survived. Returns the survivor count.
+inline size_t miller_rabin_pass(const uint64_t* in, size_t* index, size_t count,
+                                const uint64_t* witnesses, int num_witnesses) {
+    size_t survivors = 0;
+    for (size_t k = 0; k < count; k += BATCH_LANES) {
+        uint64_t group[BATCH_LANES];
+        uint8_t result[BATCH_LANES];
+        size_t filled = count - k < (size_t)BATCH_LANES ? count - k : BATCH_LANES;
+        for (int l = 0; l < BATCH_LANES; ++l) {
+            group[l] = (size_t)l < filled ? in[index[k + l]] : 10007; // pad with a known prime
+        }
+        miller_rabin_lanes(group, result, witnesses, num_witnesses);
+        for (size_t l = 0; l < filled; ++l) {
+            if (result[l]) index[survivors++] = index[k + l];
+        }
+    }
+    return survivors;
+}
+
+// out[i] = 1 if in[i] is prime, 0 otherwise (deterministic for all 64-bit inputs).
+// 'index' is scratch space for the undecided inputs: callers testing many batches can
+// pass the same vector every time so that only the first call allocates.
+inline void is_prime_batch(const uint64_t* in, uint8_t* out, size_t n, std::vector<size_t>& index) {
+    static const uint64_t witnesses[] = {
+        2, 325, 9375, 28178, 450775, 9780504, 1795265022
+    };
+
+    batch_prefilter(in, out, n);
+
+    index.clear();
+    for (size_t i = 0; i < n; ++i) {
+        if (out[i] == BATCH_UNDECIDED) {
+            out[i] = BATCH_COMPOSITE;
+            index.push_back(i);
+        }
+    }
+
+    size_t count = miller_rabin_pass(in, index.data(), index.size(), witnesses, 1);
+    count = miller_rabin_pass(in, index.data(), count, witnesses + 1, 6);
+    for (size_t k = 0; k < count; ++k) out[index[k]] = BATCH_PRIME;
+}
+
+inline void is_prime_batch(const uint64_t* in, uint8_t* out, size_t n) {
+    std::vector<size_t> index;
+    is_prime_batch(in, out, n, index);
+}
+
+// Convenience overload for containers
+inline std::vector<uint8_t> is_prime_batch(const std::vector<uint64_t>& in) {
+    std::vector<uint8_t> out(in.size());
+    is_prime_batch(in.data(), out.data(), in.size());
+    return out;
+}
+
+#endif // PRIME_BATCH_H
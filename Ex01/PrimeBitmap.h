@@ -0,0 +1,70 @@
+// PrimeBitmap.h
+// Prime bitmap generated at compile time by a constexpr sieve (C++17).
+//
+// Mod-30 wheel encoding (see Wheel30.h): one byte describes 30 integers.
+
+#ifndef PRIME_BITMAP_H
+#define PRIME_BITMAP_H
+
+#include <array>
+#include <cstdint>
+#include "Wheel30.h"
+
+// Exclusive upper bound covered by the bitmap (2^20 by default, 35 KB of .rodata).
+// Larger bounds such as 2^24 (559 KB) work, but need a higher constexpr budget and
+// take about a minute to compile, e.g. with GCC:
+//   -DPRIME_BITMAP_LIMIT=16777216 -fconstexpr-ops-limit=4294967296
+#ifndef PRIME_BITMAP_LIMIT
+#define PRIME_BITMAP_LIMIT (1u << 20)
+#endif
+
+// Sieve of Eratosthenes directly on the wheel representation.
+// Only products p*q with q coprime to 30 are stored, and for a fixed residue
+// of q the product p*q always lands on the same bit while its byte advances by
+// p. Each prime is therefore crossed off with 8 strided loops of a single AND.
+template <uint32_t Limit>
+constexpr std::array<uint8_t, Limit / 30 + 1> make_prime_wheel() {
+    std::array<uint8_t, Limit / 30 + 1> wheel{};
+    for (uint32_t i = 0; i < wheel.size(); i += 4096) { // blocked: no loop may exceed the constexpr loop limit
+        for (uint32_t j = i; j < wheel.size() && j < i + 4096; ++j) wheel[j] = 0xFF;
+    }
+    wheel[0] &= uint8_t(~1u); // 1 is not prime
+
+    for (uint32_t pk = 0; pk < wheel.size(); ++pk) {
+        for (int pb = 0; pb < 8; ++pb) {
+            uint64_t p = 30 * uint64_t(pk) + WHEEL_RESIDUES[pb];
+            if (p * p >= Limit) return wheel;
+            if (!(wheel[pk] & (1u << pb))) continue;
+
+            for (int qb = 0; qb < 8; ++qb) {
+                uint64_t q = 30 * uint64_t(pk) + WHEEL_RESIDUES[qb];
+                if (q < p) q += 30; // start at q >= p: smaller factors were handled already
+                uint64_t n = p * q;
+                if (n >= Limit) continue;
+
+                uint32_t rem = n % 30;
+                uint8_t keep = uint8_t(~WHEEL_MASKS[rem]);
+                uint64_t end = (Limit - rem + 29) / 30; // bytes k with 30k + rem < Limit
+                for (uint64_t k = n / 30; k < end; k += p) wheel[k] &= keep;
+            }
+        }
+    }
+    return wheel;
+}
+
+// The table itself: evaluated by the compiler and emitted into .rodata
+inline constexpr std::array<uint8_t, PRIME_BITMAP_LIMIT / 30 + 1> prime_wheel =
+    make_prime_wheel<PRIME_BITMAP_LIMIT>();
+
+// Primality of n < PRIME_BITMAP_LIMIT: one load and one mask
+constexpr bool prime_bitmap_lookup(uint32_t n) {
+    uint8_t mask = WHEEL_MASKS[n % 30];
+    if (mask == 0) return n == 2 || n == 3 || n == 5;
+    return prime_wheel[n / 30] & mask;
+}
+
+static_assert(!prime_bitmap_lookup(1) && prime_bitmap_lookup(2) && prime_bitmap_lookup(7) &&
+              !prime_bitmap_lookup(49) && prime_bitmap_lookup(997) && !prime_bitmap_lookup(1023),
+              "compile-time prime bitmap is inconsistent");
+
+#endif // PRIME_BITMAP_H
@@ -0,0 +1,246 @@
+// PrimePi.h
+// Prime-counting function pi(x) in sublinear time (Meissel-Lehmer).
+//
+//   pi(x) = phi(x, a) + a - 1 - P2(x, a),   a = pi(x^(1/3))
+//
+// phi(x, a) counts the integers <= x with no prime factor among the first a
+// primes, P2(x, a) counts the products p*q <= x of two primes p_a < p <= q.
+// Both only need pi(y) for y <= x^(2/3), which PiTable answers in O(1) from a
+// mod-30 wheel bitmap; the whole computation is about O(x^(2/3)) instead of
+// the O(x) of any sieve over [0, x].
+
+#ifndef PRIME_PI_H
+#define PRIME_PI_H
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include "Wheel30.h"
+#include "PrimeBitmap.h"
+#include "PrimeSieve.h"
+
+// Bits of the residues <= r within one wheel byte
+constexpr std::array<uint8_t, 30> make_wheel_le_masks() {
+    std::array<uint8_t, 30> masks{};
+    for (int r = 0; r < 30; ++r) {
+        for (int b = 0; b < 8; ++b) {
+            if ((int)WHEEL_RESIDUES[b] <= r) masks[r] |= uint8_t(1u << b);
+        }
+    }
+    return masks;
+}
+constexpr std::array<uint8_t, 30> WHEEL_LE_MASKS = make_wheel_le_masks();
+
+// pi(n) for every n < limit in O(1): wheel bitmap words plus a running count per word
+class PiTable {
+public:
+    // Below PRIME_BITMAP_LIMIT the compile-time bitmap is reused as is;
+    // larger tables are filled by the segmented sieve.
+    explicit PiTable(uint64_t limit, unsigned threads = 0) : _limit(std::max<uint64_t>(limit, 1)) {
+        uint64_t bytes = (_limit + 29) / 30;
+        std::vector<uint64_t> words(bytes / 8 + 1, 0);
+        uint8_t* wheel = reinterpret_cast<uint8_t*>(words.data());
+        if (_limit <= PRIME_BITMAP_LIMIT) {
+            std::memcpy(wheel, prime_wheel.data(), bytes);
+        } else {
+            SegmentedSieve(_limit, threads).for_each(7, _limit, [&](uint64_t p) {
+                wheel[p / 30] |= WHEEL_MASKS[p % 30];
+            });
+        }
+        // Clear stored bits at or above the limit in the last byte
+        for (uint64_t n = _limit; n < 30 * bytes; ++n) {
+            wheel[n / 30] &= uint8_t(~WHEEL_MASKS[n % 30]);
+        }
+
+        _entries.resize(words.size());
+        uint64_t running = 0;
+        for (size_t w = 0; w < words.size(); ++w) {
+            _entries[w].bits = words[w];
+            _entries[w].count = running;
+            running += __builtin_popcountll(words[w]);
+        }
+    }
+
+    uint64_t limit() const { return _limit; }
+
+    // Number of primes <= n, for n < limit()
+    uint64_t pi(uint64_t n) const {
+        if (n < 7) return n < 2 ? 0 : n < 3 ? 1 : n < 5 ? 2 : 3;
+        uint64_t w = n / 240;          // 8 wheel bytes = 240 integers per word
+        uint64_t j = (n % 240) / 30;   // byte within the word
+        uint64_t below = (uint64_t(1) << (8 * j)) - 1;
+        uint64_t mask = below | (uint64_t(WHEEL_LE_MASKS[n % 30]) << (8 * j));
+        return 3 + _entries[w].count + __builtin_popcountll(_entries[w].bits & mask);
+    }
+
+    // All primes <= n (n < limit()) in increasing order
+    std::vector<uint32_t> primes_upto(uint64_t n) const {
+        std::vector<uint32_t> primes;
+        for (uint32_t p : {2u, 3u, 5u}) {
+            if (p <= n) primes.push_back(p);
+        }
+        for (uint64_t k = 0; 30 * k <= n; ++k) {
+            uint8_t byte = uint8_t(_entries[k / 8].bits >> (8 * (k % 8)));
+            for (int b = 0; b < 8; ++b) {
+                uint64_t p = 30 * k + WHEEL_RESIDUES[b];
+                if (p <= n && (byte >> b) & 1) primes.push_back((uint32_t)p);
+            }
+        }
+        return primes;
+    }
+
+private:
+    uint64_t _limit;
+    // One word of the wheel next to the primes counted before it, so that a
+    // lookup touches a single cache line
+    struct Entry {
+        uint64_t bits;  // 8 wheel bytes (little-endian)
+        uint64_t count; // primes > 5 stored in all earlier words
+    };
+    std::vector<Entry> _entries;
+};
+
+// Legendre's partial sieve function with the shortcuts of Meissel-Lehmer
+class PhiCalculator {
+public:
+    // Number of leading primes handled by the closed-form primorial tables (2*3*5*7*11*13 = 30030)
+    static const int SMALL_A = 6;
+
+    PhiCalculator(const std::vector<uint32_t>& primes, const PiTable& table)
+    : _primes(primes), _table(table)
+    {
+        // _small[k][r] = phi(r, k) for r < p_1 * ... * p_k
+        _small.resize(SMALL_A + 1);
+        _primorial.resize(SMALL_A + 1);
+        _primorial[0] = 1;
+        _small[0] = std::vector<uint32_t>(1, 0);
+        for (int k = 1; k <= SMALL_A; ++k) {
+            _primorial[k] = _primorial[k - 1] * primes[k - 1];
+            _small[k].resize(_primorial[k]);
+            uint32_t count = 0;
+            for (uint32_t r = 0; r < _primorial[k]; ++r) {
+                bool coprime = r > 0;
+                for (int i = 0; i < k && coprime; ++i) coprime = r % primes[i] != 0;
+                count += coprime;
+                _small[k][r] = count;
+            }
+        }
+    }
+
+    // phi(x, a) for a <= primes.size()
+    uint64_t phi(uint64_t x, size_t a) const {
+        if (x == 0) return 0;
+        if (a <= (size_t)SMALL_A) return phi_small(x, (int)a);
+        // Only 1 and primes survive when x < p_{a+1}^2
+        if (a < _primes.size() && x < _table.limit() &&
+            x < uint64_t(_primes[a]) * _primes[a]) {
+            uint64_t pi = _table.pi(x);
+            return pi > a ? pi - a + 1 : 1;
+        }
+        // phi(x, a) = phi(x, SMALL_A) - sum_{SMALL_A < i <= a} phi(x / p_i, i - 1)
+        return phi_small(x, SMALL_A) - phi_terms(x, SMALL_A + 1, a);
+    }
+
+    // Same as phi(x, a) with the top-level terms spread over worker threads
+    uint64_t phi_parallel(uint64_t x, size_t a, unsigned threads) const {
+        if (a <= (size_t)SMALL_A || threads <= 1) return phi(x, a);
+        std::atomic<size_t> next(SMALL_A + 1);
+        std::atomic<uint64_t> subtracted(0);
+        auto worker = [&]() {
+            uint64_t local = 0;
+            for (size_t i = next++; i <= a; i = next++) local += phi_terms(x, i, i);
+            subtracted += local;
+        };
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) pool.emplace_back(worker);
+        for (auto& t : pool) t.join();
+        return phi_small(x, SMALL_A) - subtracted;
+    }
+
+private:
+    const std::vector<uint32_t>& _primes;
+    const PiTable& _table;
+    std::vector<std::vector<uint32_t>> _small;
+    std::vector<uint64_t> _primorial;
+
+    // sum_{first <= i <= last} phi(x / p_i, i - 1)
+    uint64_t phi_terms(uint64_t x, size_t first, size_t last) const {
+        uint64_t sum = 0;
+        size_t i = first;
+        // Terms that still need the recursion: x / p_i >= p_i^2 (or beyond the table)
+        for (; i <= last; ++i) {
+            uint64_t p = _primes[i - 1];
+            uint64_t y = fast_div(x, p);
+            if (y < _table.limit() && y < p * p) break;
+            sum += phi(y, i - 1);
+        }
+        // From here on y = x / p_i < p_i^2 for every later i as well, so
+        // phi(y, i - 1) = pi(y) - (i - 1) + 1 when y >= p_i, and 1 below that
+        for (; i <= last; ++i) {
+            uint64_t p = _primes[i - 1];
+            uint64_t y = fast_div(x, p);
+            if (y < p) { // y only shrinks from here: the rest contribute 1 each
+                sum += last - i + 1;
+                break;
+            }
+            sum += _table.pi(y) - i + 2;
+        }
+        return sum;
+    }
+
+    uint64_t phi_small(uint64_t x, int k) const {
+        uint32_t m = (uint32_t)_primorial[k];
+        uint64_t q = fast_div(x, m);
+        return q * _small[k][m - 1] + _small[k][x - q * m];
+    }
+
+    // Almost every x in the recursion fits in 32 bits, where division is several times cheaper
+    static uint64_t fast_div(uint64_t x, uint32_t d) {
+        return x <= UINT32_MAX ? uint32_t(x) / d : x / d;
+    }
+};
+
+// Number of primes <= x. threads == 0 uses every hardware thread.
+inline uint64_t prime_pi(uint64_t x, unsigned threads = 0) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    if (x < PRIME_BITMAP_LIMIT) return PiTable(PRIME_BITMAP_LIMIT).pi(x);
+
+    auto iroot = [](uint64_t v, int k) { // floor(v^(1/k))
+        uint64_t r = (uint64_t)std::pow((long double)v, 1.0L / k);
+        auto pow_le = [&](uint64_t b) { // b^k <= v without overflow
+            uint64_t p = 1;
+            for (int i = 0; i < k; ++i) {
+                if (p > v / b) return false;
+                p *= b;
+            }
+            return true;
+        };
+        while (r > 1 && !pow_le(r)) --r;
+        while (pow_le(r + 1)) ++r;
+        return r;
+    };
+    uint64_t cbrt = iroot(x, 3), sqrt = iroot(x, 2);
+
+    // pi(y) is needed for y <= x / p_{a+1} < x^(2/3), and the primes up to sqrt(x)
+    uint64_t limit = std::max(x / cbrt, sqrt) + 1;
+    PiTable table(limit, threads);
+    std::vector<uint32_t> primes = table.primes_upto(sqrt);
+
+    size_t a = table.pi(cbrt);
+    size_t b = primes.size(); // pi(sqrt(x))
+
+    PhiCalculator calculator(primes, table);
+    uint64_t result = calculator.phi_parallel(x, a, threads) + a - 1;
+
+    // P2(x, a) = sum_{a < i <= b} (pi(x / p_i) - (i - 1))
+    for (size_t i = a + 1; i <= b; ++i) {
+        result -= table.pi(x / primes[i - 1]) - (i - 1);
+    }
+    return result;
+}
+
+#endif // PRIME_PI_H
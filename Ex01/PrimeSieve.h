@@ -0,0 +1,375 @@
+// PrimeSieve.h
+// Odd-only segmented Sieve of Eratosthenes for enumerating primes in [lo, hi).
+
+#ifndef PRIME_SIEVE_H
+#define PRIME_SIEVE_H
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <algorithm>
+#include <iterator>
+
+class SegmentedSieve {
+public:
+    // One segment holds 2^18 odd numbers as bits (32 KiB), so it stays in L1/L2
+    // while every base prime crosses it off.
+    static constexpr uint64_t SEGMENT_SHIFT = 18;
+    static constexpr uint64_t SEGMENT_BITS = uint64_t(1) << SEGMENT_SHIFT;
+    static constexpr uint64_t SEGMENT_SPAN = 2 * SEGMENT_BITS; // integers covered by one segment
+
+    // Prepares a sieve for ranges below hi. threads == 0 uses every hardware thread.
+    // hi must stay below 2^64 - 2^33 so that segment arithmetic cannot overflow.
+    explicit SegmentedSieve(uint64_t hi, unsigned threads = 0)
+    : _hi(hi), _threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency()))
+    {
+        uint64_t root = (uint64_t)std::sqrt((long double)hi);
+        while (root * root > hi) --root;
+        while (root + 1 <= hi / (root + 1)) ++root;
+        _base_primes = small_primes(root);
+        build_pattern();
+    }
+
+    // Number of primes p with lo <= p < hi
+    uint64_t count(uint64_t lo, uint64_t hi) const {
+        hi = std::min(hi, _hi);
+        if (lo >= hi) return 0;
+
+        uint64_t total = (lo <= 2 && 2 < hi) ? 1 : 0;
+        uint64_t first = lo | 1; // first odd number >= lo
+        if (first >= hi) return total;
+        uint64_t num_segments = (hi - first + SEGMENT_SPAN - 1) / SEGMENT_SPAN;
+
+        // Each thread sieves one contiguous run of segments
+        unsigned n = (unsigned)std::min<uint64_t>(_threads, num_segments);
+        std::atomic<uint64_t> sum(0);
+        auto worker = [&](unsigned t) {
+            std::vector<uint64_t> bits(SEGMENT_BITS / 64);
+            uint64_t local = 0;
+            sieve_run(first, hi, num_segments * t / n, num_segments * (t + 1) / n,
+                      [&](uint64_t) -> std::vector<uint64_t>& { return bits; },
+                      [&](uint64_t, uint64_t, uint64_t nbits, const std::vector<uint64_t>& b) {
+                          for (uint64_t w = 0; w < (nbits + 63) / 64; ++w) {
+                              local += __builtin_popcountll(b[w]);
+                          }
+                      });
+            sum += local;
+        };
+        if (n <= 1) {
+            worker(0);
+        } else {
+            std::vector<std::thread> pool;
+            for (unsigned t = 0; t < n; ++t) pool.emplace_back(worker, t);
+            for (auto& t : pool) t.join();
+        }
+        return total + sum;
+    }
+
+    // Calls cb(p) for every prime lo <= p < hi, in increasing order, on the calling thread.
+    // Worker threads sieve runs of RUN_SEGMENTS consecutive segments ahead into a ring of
+    // buffers.
+    template <class Callback>
+    void for_each(uint64_t lo, uint64_t hi, Callback cb) const {
+        hi = std::min(hi, _hi);
+        if (lo >= hi) return;
+
+        if (lo <= 2 && 2 < hi) cb(uint64_t(2));
+        uint64_t first = lo | 1;
+        if (first >= hi) return;
+        uint64_t num_segments = (hi - first + SEGMENT_SPAN - 1) / SEGMENT_SPAN;
+
+        auto emit = [&](uint64_t, uint64_t seg_lo, uint64_t nbits, const std::vector<uint64_t>& bits) {
+            for (uint64_t w = 0; w < (nbits + 63) / 64; ++w) {
+                uint64_t word = bits[w];
+                while (word) {
+                    uint64_t i = w * 64 + __builtin_ctzll(word);
+                    cb(seg_lo + 2 * i);
+                    word &= word - 1;
+                }
+            }
+        };
+
+        if (_threads == 1 || num_segments <= RUN_SEGMENTS) {
+            std::vector<uint64_t> bits(SEGMENT_BITS / 64);
+            sieve_run(first, hi, 0, num_segments,
+                      [&](uint64_t) -> std::vector<uint64_t>& { return bits; }, emit);
+            return;
+        }
+
+        // Ring of 2 runs per worker: segment s lives in slot s % ring until consumed
+        const uint64_t ring = 2 * RUN_SEGMENTS * _threads;
+        std::vector<std::vector<uint64_t>> buffers(ring, std::vector<uint64_t>(SEGMENT_BITS / 64));
+        std::vector<uint64_t> ready(ring, UINT64_MAX); // segment index held by each slot
+        uint64_t consumed = 0;                         // segments handed to cb so far
+        std::atomic<uint64_t> next(0);
+        std::mutex m;
+        std::condition_variable cv;
+
+        auto slot = [&](uint64_t s) -> std::vector<uint64_t>& {
+            std::unique_lock<std::mutex> lock(m);
+            cv.wait(lock, [&] { return s < consumed + ring; });
+            return buffers[s % ring];
+        };
+        auto publish = [&](uint64_t s, uint64_t, uint64_t, const std::vector<uint64_t>&) {
+            {
+                std::lock_guard<std::mutex> lock(m);
+                ready[s % ring] = s;
+            }
+            cv.notify_all();
+        };
+        auto worker = [&]() {
+            for (uint64_t s = next.fetch_add(RUN_SEGMENTS); s < num_segments; s = next.fetch_add(RUN_SEGMENTS)) {
+                sieve_run(first, hi, s, std::min(s + RUN_SEGMENTS, num_segments), slot, publish);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        unsigned n = (unsigned)std::min<uint64_t>(_threads, (num_segments + RUN_SEGMENTS - 1) / RUN_SEGMENTS);
+        for (unsigned t = 0; t < n; ++t) pool.emplace_back(worker);
+
+        for (uint64_t s = 0; s < num_segments; ++s) {
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait(lock, [&] { return ready[s % ring] == s; });
+            }
+            uint64_t seg_lo = first + s * SEGMENT_SPAN;
+            emit(s, seg_lo, segment_bits(seg_lo, hi), buffers[s % ring]);
+            {
+                std::lock_guard<std::mutex> lock(m);
+                consumed = s + 1;
+            }
+            cv.notify_all();
+        }
+        for (auto& t : pool) t.join();
+    }
+
+    // Plain sieve of Eratosthenes: all primes <= limit (used for the base primes)
+    static std::vector<uint32_t> small_primes(uint64_t limit) {
+        std::vector<uint32_t> primes;
+        if (limit < 2) return primes;
+        std::vector<bool> composite(limit + 1, false);
+        for (uint64_t i = 2; i <= limit; ++i) {
+            if (composite[i]) continue;
+            primes.push_back((uint32_t)i);
+            for (uint64_t j = i * i; j <= limit; j += i) composite[j] = true;
+        }
+        return primes;
+    }
+
+private:
+    // Segments sieved in a row by one for_each worker
+    static constexpr uint64_t RUN_SEGMENTS = 16;
+
+    // Odd primes removed by copying a precomputed pattern instead of crossing off
+    static constexpr uint32_t PRESIEVE_PRIMES[] = {3, 5, 7, 11, 13, 17};
+    static constexpr uint64_t PRESIEVE_PERIOD = 3 * 5 * 7 * 11 * 13 * 17; // in bits (odd numbers)
+
+    // Primes below 64 hit a word several times: for each such prime and each offset i of its
+    // next multiple in a word, the word's mask and the offset in the following word
+    struct WordStep {
+        uint64_t mask;
+        uint32_t next;
+    };
+
+    uint64_t _hi;                       // exclusive upper bound the base primes cover
+    unsigned _threads;                  // number of worker threads
+    std::vector<uint32_t> _base_primes; // primes <= sqrt(hi)
+    std::vector<uint64_t> _pattern;     // bit t set unless 2t+1 has a factor in PRESIEVE_PRIMES
+    std::vector<WordStep> _word_steps;  // 64 entries per base prime after PRESIEVE_PRIMES and below 64
+
+    // Next multiple of a base prime >= SEGMENT_BITS, as an offset in the segment it falls in
+    struct BucketEntry {
+        uint32_t prime;
+        uint32_t offset;
+    };
+
+    // Number of odd numbers of the segment starting at seg_lo that lie below hi
+    static uint64_t segment_bits(uint64_t seg_lo, uint64_t hi) {
+        return std::min(SEGMENT_BITS, (hi - seg_lo + 1) / 2);
+    }
+
+    // One period of the pattern, repeated to cover any segment from any phase
+    void build_pattern() {
+        uint64_t nbits = PRESIEVE_PERIOD + SEGMENT_BITS + 64;
+        _pattern.assign((nbits + 63) / 64 + 1, 0);
+        for (uint64_t t = 0; t < nbits; ++t) {
+            uint64_t n = 2 * t + 1;
+            bool keep = true;
+            for (uint32_t p : PRESIEVE_PRIMES) keep = keep && n % p != 0;
+            if (keep) _pattern[t / 64] |= uint64_t(1) << (t % 64);
+        }
+
+        for (size_t k = std::size(PRESIEVE_PRIMES) + 1; k < _base_primes.size() && _base_primes[k] < 64; ++k) {
+            uint32_t p = _base_primes[k];
+            for (uint32_t i = 0; i < 64; ++i) {
+                WordStep step{0, i};
+                for (; step.next < 64; step.next += p) step.mask |= uint64_t(1) << step.next;
+                step.next -= 64;
+                _word_steps.push_back(step);
+            }
+        }
+    }
+
+    // First odd multiple of p that is >= lo and >= p * p
+    static uint64_t first_multiple(uint64_t p, uint64_t lo) {
+        uint64_t start = p * p;
+        if (start < lo) {
+            start = (lo + p - 1) / p * p;
+            if (start % 2 == 0) start += p;
+        }
+        return start;
+    }
+
+    // Sieves segments [s_begin, s_end) of the range starting at the odd number first, in order.
+    // Bit i of segment s represents first + s * SEGMENT_SPAN + 2i; the segment is sieved into
+    // buffer(s) and then passed to done(s, seg_lo, nbits, bits).
+    // The position of the next multiple of each base prime is computed with one division
+    // at the start of the run and then carried from segment to segment: primes below
+    // SEGMENT_BITS keep an offset, larger primes (which hit a segment at most once) wait in
+    // the bucket of the segment holding their next multiple.
+    template <class Buffer, class Done>
+    void sieve_run(uint64_t first, uint64_t hi, uint64_t s_begin, uint64_t s_end, Buffer buffer, Done done) const {
+        if (s_begin >= s_end) return;
+        const uint64_t num_segments = s_end - s_begin;
+        const uint64_t run_lo = first + s_begin * SEGMENT_SPAN;
+        const uint64_t run_hi = std::min(hi, first + s_end * SEGMENT_SPAN);
+
+        // Base primes needed for this run: 19 <= p (2 and the presieve primes 3..17 are
+        // skipped), p * p < run_hi
+        size_t k_begin = std::size(PRESIEVE_PRIMES) + 1;
+        size_t k_end = k_begin;
+        while (k_end < _base_primes.size() && (uint64_t)_base_primes[k_end] * _base_primes[k_end] < run_hi) ++k_end;
+        size_t k_large = k_begin;
+        while (k_large < k_end && _base_primes[k_large] < SEGMENT_BITS) ++k_large;
+
+        std::vector<uint64_t> offset; // small primes: next multiple, in bits from the current segment
+        offset.reserve(k_large - k_begin);
+        for (size_t k = k_begin; k < k_large; ++k) {
+            offset.push_back((first_multiple(_base_primes[k], run_lo) - run_lo) / 2);
+        }
+
+        // Buckets for the next num_buckets segments (a large prime's next multiple is
+        // always less than num_buckets segments ahead)
+        uint64_t num_buckets = 1;
+        if (k_large < k_end) {
+            while (num_buckets < ((uint64_t)_base_primes[k_end - 1] >> SEGMENT_SHIFT) + 2) num_buckets *= 2;
+        }
+        std::vector<std::vector<BucketEntry>> buckets(num_buckets);
+        std::vector<BucketEntry> current;
+        size_t k_pending = k_large; // large primes whose first multiple p * p is too far ahead yet
+
+        for (uint64_t j = 0; j < num_segments; ++j) {
+            uint64_t s = s_begin + j;
+            uint64_t seg_lo = run_lo + j * SEGMENT_SPAN;
+            uint64_t nbits = segment_bits(seg_lo, hi);
+            uint64_t seg_hi = seg_lo + 2 * nbits;
+            std::vector<uint64_t>& bits = buffer(s);
+
+            // Pre-sieve: copy the pattern from the phase of seg_lo
+            uint64_t words = (nbits + 63) / 64;
+            uint64_t phase = ((seg_lo - 1) / 2) % PRESIEVE_PERIOD;
+            uint64_t q = phase / 64, r = phase % 64;
+            for (uint64_t w = 0; w < words; ++w) {
+                bits[w] = r ? (_pattern[q + w] >> r) | (_pattern[q + w + 1] << (64 - r)) : _pattern[q + w];
+            }
+            if (nbits % 64) bits[words - 1] &= (uint64_t(1) << (nbits % 64)) - 1;
+            if (seg_lo <= PRESIEVE_PRIMES[std::size(PRESIEVE_PRIMES) - 1]) {
+                for (uint32_t p : PRESIEVE_PRIMES) {
+                    if (p >= seg_lo && p < seg_hi) bits[(p - seg_lo) / 2 / 64] |= uint64_t(1) << ((p - seg_lo) / 2 % 64);
+                }
+            }
+
+            // Small primes cross off several multiples per segment. Below 64 a word holds
+            // several multiples: each word is masked once, with the steps from the table.
+            // Primes whose next multiple is in the first word go through the words together,
+            // so the table lookups of different primes overlap.
+            size_t k = k_begin;
+            size_t k_words = k_begin;
+            while (k_words < k_large && _base_primes[k_words] < 64) ++k_words;
+            uint32_t word_offset[64];
+            size_t together = 0;
+            for (; k < k_words && offset[k - k_begin] < 64; ++k) word_offset[together++] = (uint32_t)offset[k - k_begin];
+            if (together > 0) {
+                const WordStep* steps = &_word_steps[0];
+                for (uint64_t w = 0; w < words; ++w) {
+                    uint64_t mask = 0;
+                    for (size_t t = 0; t < together; ++t) {
+                        const WordStep& step = steps[64 * t + word_offset[t]];
+                        mask |= step.mask;
+                        word_offset[t] = step.next;
+                    }
+                    bits[w] &= ~mask;
+                }
+                for (size_t t = 0; t < together; ++t) offset[t] = word_offset[t]; // in the word after the segment
+            }
+            for (; k < k_words; ++k) { // multiple p * p still ahead
+                uint64_t i = offset[k - k_begin];
+                if (i < nbits) {
+                    const WordStep* steps = &_word_steps[64 * (k - k_begin)];
+                    uint32_t b = (uint32_t)(i % 64);
+                    for (uint64_t w = i / 64; w < words; ++w) {
+                        bits[w] &= ~steps[b].mask;
+                        b = steps[b].next;
+                    }
+                    i = SEGMENT_BITS + b; // b is the offset in the word after the segment
+                }
+                offset[k - k_begin] = i - SEGMENT_BITS; // only used if the segment was full
+            }
+            for (; k < k_large; ++k) {
+                uint64_t p = _base_primes[k];
+                uint64_t i = offset[k - k_begin];
+                for (; i + 3 * p < nbits; i += 4 * p) {
+                    bits[i / 64] &= ~(uint64_t(1) << (i % 64));
+                    bits[(i + p) / 64] &= ~(uint64_t(1) << ((i + p) % 64));
+                    bits[(i + 2 * p) / 64] &= ~(uint64_t(1) << ((i + 2 * p) % 64));
+                    bits[(i + 3 * p) / 64] &= ~(uint64_t(1) << ((i + 3 * p) % 64));
+                }
+                for (; i < nbits; i += p) bits[i / 64] &= ~(uint64_t(1) << (i % 64));
+                offset[k - k_begin] = i - SEGMENT_BITS; // only used if the segment was full
+            }
+
+            // Large primes: move in those whose p * p is now close, then cross off this segment's bucket
+            while (k_pending < k_end) {
+                uint64_t p = _base_primes[k_pending];
+                uint64_t g = (first_multiple(p, run_lo) - run_lo) / 2;
+                if ((g >> SEGMENT_SHIFT) >= j + num_buckets) break; // p * p grows with p
+                if ((g >> SEGMENT_SHIFT) < num_segments) {
+                    buckets[(g >> SEGMENT_SHIFT) & (num_buckets - 1)].push_back(
+                        BucketEntry{(uint32_t)p, (uint32_t)(g & (SEGMENT_BITS - 1))});
+                }
+                ++k_pending;
+            }
+            current.swap(buckets[j & (num_buckets - 1)]);
+            for (const BucketEntry& e : current) {
+                if (e.offset < nbits) bits[e.offset / 64] &= ~(uint64_t(1) << (e.offset % 64));
+                uint64_t next = e.offset + (uint64_t)e.prime;
+                uint64_t ns = j + (next >> SEGMENT_SHIFT);
+                if (ns < num_segments) {
+                    buckets[ns & (num_buckets - 1)].push_back(
+                        BucketEntry{e.prime, (uint32_t)(next & (SEGMENT_BITS - 1))});
+                }
+            }
+            current.clear();
+
+            if (seg_lo == 1) bits[0] &= ~uint64_t(1); // 1 is not prime
+            done(s, seg_lo, nbits, bits);
+        }
+    }
+};
+
+// Number of primes p with lo <= p < hi
+inline uint64_t count_primes(uint64_t lo, uint64_t hi, unsigned threads = 0) {
+    return SegmentedSieve(hi, threads).count(lo, hi);
+}
+
+// Calls cb(p) for every prime lo <= p < hi in increasing order
+template <class Callback>
+void for_each_prime(uint64_t lo, uint64_t hi, Callback cb, unsigned threads = 0) {
+    SegmentedSieve(hi, threads).for_each(lo, hi, cb);
+}
+
+#endif // PRIME_SIEVE_H
@@ -0,0 +1,147 @@
+// PrimeTable.h
+// Persistent mod-30 wheel prime table, memory-mapped read-only.
+//
+// The file is written once by make_prime_table (see make_prime_table.cpp) and
+// mapped by every process that needs it: the page cache holds one physical copy
+// for all of them, and opening the table costs a single mmap instead of a sieve.
+//
+// File layout (little-endian, native struct layout):
+//   PrimeTableHeader (64 bytes)
+//   wheel bytes: bit b of byte k is set iff 30k + WHEEL_RESIDUES[b] is prime
+
+#ifndef PRIME_TABLE_H
+#define PRIME_TABLE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Wheel30.h"
+#include "PrimeSieve.h"
+#include "MillerRabin.h"
+
+const char PRIME_TABLE_MAGIC[8] = {'P', 'R', 'I', 'M', 'E', 'W', '3', '0'};
+const uint32_t PRIME_TABLE_VERSION = 1;
+const uint64_t PRIME_TABLE_DEFAULT_LIMIT = uint64_t(1) << 32;
+
+struct PrimeTableHeader {
+    char magic[8];        // PRIME_TABLE_MAGIC
+    uint32_t version;     // PRIME_TABLE_VERSION
+    uint32_t header_size; // offset of the wheel bytes
+    uint64_t limit;       // the table answers every n < limit
+    uint64_t data_size;   // number of wheel bytes
+    uint64_t prime_count; // pi(limit), for validation
+    char reserved[24];    // zero
+};
+static_assert(sizeof(PrimeTableHeader) == 64, "PrimeTableHeader must stay 64 bytes");
+
+// Sieves [0, limit) and writes the table to path.
+// The file is written to path + ".tmp" first and renamed, so readers never see a partial table.
+// Throws std::runtime_error on I/O failure.
+inline void write_prime_table(const std::string& path, uint64_t limit = PRIME_TABLE_DEFAULT_LIMIT) {
+    std::vector<uint8_t> wheel((limit + 29) / 30, 0);
+    uint64_t count = 0;
+    for_each_prime(0, limit, [&](uint64_t p) {
+        ++count;
+        if (p > 5) wheel[p / 30] |= WHEEL_MASKS[p % 30];
+    });
+
+    PrimeTableHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, PRIME_TABLE_MAGIC, sizeof(header.magic));
+    header.version = PRIME_TABLE_VERSION;
+    header.header_size = sizeof(PrimeTableHeader);
+    header.limit = limit;
+    header.data_size = wheel.size();
+    header.prime_count = count;
+
+    std::string tmp = path + ".tmp";
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) throw std::runtime_error("Cannot create prime table: " + tmp);
+    bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1 &&
+              std::fwrite(wheel.data(), 1, wheel.size(), f) == wheel.size();
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        throw std::runtime_error("Cannot write prime table: " + path);
+    }
+}
+
+// Read-only view of a prime table file
+class MappedPrimeTable {
+public:
+    // Maps the table at path; throws std::runtime_error if it is missing or invalid
+    explicit MappedPrimeTable(const std::string& path)
+    : _map(nullptr), _map_size(0), _wheel(nullptr), _limit(0), _prime_count(0)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) throw std::runtime_error("Cannot open prime table: " + path);
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(PrimeTableHeader)) {
+            ::close(fd);
+            throw std::runtime_error("Prime table is truncated: " + path);
+        }
+        _map_size = (size_t)st.st_size;
+        void* map = ::mmap(nullptr, _map_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd); // the mapping keeps the file alive
+        if (map == MAP_FAILED) throw std::runtime_error("Cannot map prime table: " + path);
+        _map = map;
+
+        const PrimeTableHeader* header = static_cast<const PrimeTableHeader*>(_map);
+        if (std::memcmp(header->magic, PRIME_TABLE_MAGIC, sizeof(header->magic)) != 0 ||
+            header->version != PRIME_TABLE_VERSION ||
+            header->header_size < sizeof(PrimeTableHeader) ||
+            header->header_size > _map_size ||
+            header->limit > UINT64_MAX - 29 || // (limit + 29) / 30 must not wrap
+            header->data_size != (header->limit + 29) / 30 ||
+            header->data_size > _map_size - header->header_size) {
+            unmap();
+            throw std::runtime_error("Invalid or incompatible prime table: " + path);
+        }
+        _wheel = static_cast<const uint8_t*>(_map) + header->header_size;
+        _limit = header->limit;
+        _prime_count = header->prime_count;
+        ::madvise(_map, _map_size, MADV_RANDOM); // lookups are random: skip readahead
+    }
+
+    ~MappedPrimeTable() { unmap(); }
+
+    // Prevent copy operations (the mapping has a single owner)
+    MappedPrimeTable(const MappedPrimeTable&) = delete;
+    MappedPrimeTable& operator=(const MappedPrimeTable&) = delete;
+
+    // The table answers every n < limit()
+    uint64_t limit() const { return _limit; }
+
+    // Number of primes below limit(), as recorded by the writer
+    uint64_t prime_count() const { return _prime_count; }
+
+    // Primality of n < limit(): one load from the page cache
+    bool contains(uint64_t n) const { return wheel_lookup(_wheel, n); }
+
+    // Primality of any n: table lookup when covered, Miller-Rabin otherwise
+    bool isPrime(uint64_t n) const {
+        return n < _limit ? contains(n) : isPrime_miller_rabin(n);
+    }
+
+private:
+    void* _map;            // whole file mapping
+    size_t _map_size;      // size of the mapping
+    const uint8_t* _wheel; // first wheel byte inside the mapping
+    uint64_t _limit;       // exclusive bound of the table
+    uint64_t _prime_count; // pi(limit)
+
+    void unmap() {
+        if (_map) ::munmap(_map, _map_size);
+        _map = nullptr;
+    }
+};
+
+#endif // PRIME_TABLE_H
@@ -0,0 +1,42 @@
+// Qestion2.h
+// 素数判定 (Question 2): ビットマップ + 試割り法
+
+#ifndef QESTION2_H
+#define QESTION2_H
+
+#include <cstdint>
+#include "PrimeBitmap.h"
+
+// コンパイル時に生成された素数ビットマップ (PrimeBitmap.h)
+// mod 30 のホイール表現: 1バイトで30個の整数を表し、PRIME_BITMAP_LIMIT 未満を網羅する
+
+// 従来の素数判定アルゴリズム（試割り法）
+inline bool isPrime_fallback(int n) {
+    if (n <= 1) return false;
+    if (n <= 3) return true;
+    if (n % 2 == 0 || n % 3 == 0) return false;
+    for (int i = 5; i <= n / i; i = i + 6) { // i * i <= n だと INT_MAX 付近でオーバーフローする
+        if (n % i == 0 || n % (i + 2) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 修正されたisPrime関数
+inline bool isPrime(int n) {
+    // 1. 負の数、0、1は素数ではない
+    if (n <= 1) {
+        return false;
+    }
+
+    // 2. PRIME_BITMAP_LIMIT 未満はビットマップを1回読むだけで判定
+    if ((uint32_t)n < PRIME_BITMAP_LIMIT) {
+        return prime_bitmap_lookup((uint32_t)n);
+    }
+
+    // 3. その他のケースは従来のアルゴリズムで判定
+    return isPrime_fallback(n);
+}
+
+#endif // QESTION2_H
@@ -0,0 +1,33 @@
+// Question1.h
+// Primality tests of Question 1 (64-bit inputs)
+
+#ifndef QUESTION1_H
+#define QUESTION1_H
+
+#include <cmath>
+#include <cstdint>
+#include "MillerRabin.h"
+
+// Trial division: only usable for small x, O(sqrt(x)) divisions
+inline bool isPrime_trial(uint64_t x) {
+    if (x < 2) return false;       
+    if (x == 2) return true;       
+    if (x % 2 == 0) return false;  
+
+    // Only check divisors up to sqrt(x)
+    uint64_t limit = (uint64_t)std::sqrt((long double)x);
+    for (uint64_t i = 3; i <= limit; i += 2) {
+        if (x % i == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Function to check if a number is prime
+// Deterministic Miller-Rabin (see MillerRabin.h): microseconds for any 64-bit x
+inline bool isPrime(uint64_t x) {
+    return isPrime_miller_rabin(x);
+}
+
+#endif // QUESTION1_H
@@ -0,0 +1,31 @@
+// Wheel30.h
+// Mod-30 wheel encoding shared by the prime bitmaps.
+//
+// Among any 30 consecutive integers only the 8 residues coprime to 30
+// (1, 7, 11, 13, 17, 19, 23, 29) can be prime above 5, so one byte describes
+// 30 integers. Bit b of byte k is set iff 30k + WHEEL_RESIDUES[b] is prime.
+
+#ifndef WHEEL30_H
+#define WHEEL30_H
+
+#include <array>
+#include <cstdint>
+
+constexpr uint32_t WHEEL_RESIDUES[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+
+// Bit mask of residue r (0..29) within a wheel byte, 0 if r shares a factor with 30
+constexpr std::array<uint8_t, 30> make_wheel_masks() {
+    std::array<uint8_t, 30> masks{};
+    for (int b = 0; b < 8; ++b) masks[WHEEL_RESIDUES[b]] = uint8_t(1u << b);
+    return masks;
+}
+constexpr std::array<uint8_t, 30> WHEEL_MASKS = make_wheel_masks();
+
+// Primality of n from a wheel bitmap that covers n
+inline bool wheel_lookup(const uint8_t* wheel, uint64_t n) {
+    uint8_t mask = WHEEL_MASKS[n % 30];
+    if (mask == 0) return n == 2 || n == 3 || n == 5;
+    return wheel[n / 30] & mask;
+}
+
+#endif // WHEEL30_H
@@ -0,0 +1,159 @@
+// bench_primality.cpp
+// Compares the Ex01 primality strategies on several input distributions.
+//
+// Usage: bench_primality [ops] [table]
+//   ops   operations per (strategy, distribution) row (default: 1048576)
+//   table optional prime table written by make_prime_table, adds the "mapped_table" rows
+//
+// Output is CSV on stdout, one row per (strategy, distribution):
+//   strategy,distribution,ops,ns_per_op,mops_per_s,p50_ns,p99_ns,primes
+// Latencies are measured over samples of SAMPLE_OPS consecutive calls (a single
+// call is too short for the clock) and reported per call. The "batch" strategy is
+// timed one is_prime_batch call over the whole input array per sample, as it would
+// be used, so its p50/p99 are the average per input within a call. "primes" counts the
+// inputs found prime: equal counts across strategies double as a correctness check.
+// Strategies are skipped on inputs outside their domain (int for Qestion2) and
+// each row stops early after TIME_BUDGET_S seconds, so slow rows report fewer ops.
+#include "Question1.h"
+#include "Qestion2.h"
+#include "PrimeBatch.h"
+#include "PrimeTable.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+const size_t INPUT_COUNT = 1 << 16; // inputs per distribution, cycled
+const size_t SAMPLE_OPS = 16;       // calls per latency sample
+const double TIME_BUDGET_S = 2.0;   // per row
+
+struct Distribution {
+    string name;
+    vector<uint64_t> inputs;
+    uint64_t max_value;
+};
+
+struct Strategy {
+    string name;
+    uint64_t max_input; // largest input the strategy accepts
+    size_t sample_ops;  // inputs per timed call of run
+    // Tests inputs[0..count) and returns how many are prime
+    function<size_t(const uint64_t* inputs, size_t count)> run;
+};
+
+// Random primes (or random odd numbers) drawn from [lo, hi]
+uint64_t random_prime(mt19937_64& rng, uint64_t lo, uint64_t hi) {
+    uint64_t n = lo + rng() % (hi - lo + 1);
+    while (!isPrime_miller_rabin(n)) n = (n >= hi) ? lo : n + 1;
+    return n;
+}
+
+vector<Distribution> make_distributions() {
+    mt19937_64 rng(2024);
+    vector<Distribution> dists;
+    auto add = [&](const string& name, uint64_t max_value, function<uint64_t()> draw) {
+        Distribution d{name, vector<uint64_t>(INPUT_COUNT), max_value};
+        for (uint64_t& v : d.inputs) v = draw();
+        dists.push_back(d);
+    };
+    add("dense_small", (1u << 20) - 1, [&] { return rng() % (1u << 20); });
+    add("uniform32", UINT32_MAX, [&] { return rng() & UINT32_MAX; });
+    add("uniform64", UINT64_MAX, [&] { return rng(); });
+    // Half primes, half random odd numbers: the worst case of every strategy
+    add("prime_heavy31", INT_MAX, [&] {
+        return (rng() & 1) ? random_prime(rng, 1u << 30, INT_MAX) : ((rng() % INT_MAX) | 1);
+    });
+    add("prime_heavy64", UINT64_MAX, [&] {
+        return (rng() & 1) ? random_prime(rng, uint64_t(1) << 63, UINT64_MAX) : (rng() | 1);
+    });
+    return dists;
+}
+
+// Runs one (strategy, distribution) row and prints it
+void bench(const Strategy& s, const Distribution& d, size_t ops) {
+    if (d.max_value > s.max_input) return;
+    // Trial division cannot finish prime-heavy 64-bit inputs (2^31 divisions per prime)
+    if (s.name == "q1_trial" && d.max_value > UINT32_MAX) return;
+
+    vector<double> samples;
+    samples.reserve(ops / s.sample_ops + 1);
+    size_t done = 0, primes = 0, pos = 0;
+    auto start = chrono::steady_clock::now();
+    while (done < ops) {
+        if (pos + s.sample_ops > d.inputs.size()) pos = 0;
+        auto t0 = chrono::steady_clock::now();
+        primes += s.run(d.inputs.data() + pos, s.sample_ops);
+        auto t1 = chrono::steady_clock::now();
+        samples.push_back(chrono::duration<double, nano>(t1 - t0).count() / s.sample_ops);
+        pos += s.sample_ops;
+        done += s.sample_ops;
+        if (chrono::duration<double>(t1 - start).count() > TIME_BUDGET_S) break;
+    }
+    double total_ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+
+    sort(samples.begin(), samples.end());
+    double p50 = samples[samples.size() / 2];
+    double p99 = samples[min(samples.size() - 1, samples.size() * 99 / 100)];
+    printf("%s,%s,%zu,%.2f,%.3f,%.2f,%.2f,%zu\n", s.name.c_str(), d.name.c_str(), done,
+           total_ns / done, done / total_ns * 1e3, p50, p99, primes);
+    fflush(stdout);
+}
+
+int main(int argc, char* argv[]) {
+    size_t ops = argc > 1 ? stoull(argv[1]) : (size_t(1) << 20);
+    unique_ptr<MappedPrimeTable> table;
+    if (argc > 2) table.reset(new MappedPrimeTable(argv[2]));
+    vector<uint8_t> batch_out(INPUT_COUNT);
+    vector<size_t> batch_index; // reused by every batch call
+
+    vector<Strategy> strategies = {
+        {"q1_trial", UINT64_MAX, SAMPLE_OPS, [](const uint64_t* in, size_t n) {
+            size_t c = 0;
+            for (size_t i = 0; i < n; ++i) c += isPrime_trial(in[i]);
+            return c;
+        }},
+        {"q1_miller_rabin", UINT64_MAX, SAMPLE_OPS, [](const uint64_t* in, size_t n) {
+            size_t c = 0;
+            for (size_t i = 0; i < n; ++i) c += isPrime(in[i]);
+            return c;
+        }},
+        {"q2_bitmap", INT_MAX, SAMPLE_OPS, [](const uint64_t* in, size_t n) {
+            size_t c = 0;
+            for (size_t i = 0; i < n; ++i) c += isPrime((int)in[i]);
+            return c;
+        }},
+        {"q2_fallback", INT_MAX, SAMPLE_OPS, [](const uint64_t* in, size_t n) {
+            size_t c = 0;
+            for (size_t i = 0; i < n; ++i) c += isPrime_fallback((int)in[i]);
+            return c;
+        }},
+        {"batch", UINT64_MAX, INPUT_COUNT, [&](const uint64_t* in, size_t n) {
+            is_prime_batch(in, batch_out.data(), n, batch_index);
+            size_t c = 0;
+            for (size_t i = 0; i < n; ++i) c += batch_out[i];
+            return c;
+        }},
+    };
+    if (table) {
+        const MappedPrimeTable* t = table.get();
+        strategies.push_back({"mapped_table", UINT64_MAX, SAMPLE_OPS, [t](const uint64_t* in, size_t n) {
+            size_t c = 0;
+            for (size_t i = 0; i < n; ++i) c += t->isPrime(in[i]);
+            return c;
+        }});
+    }
+
+    vector<Distribution> dists = make_distributions();
+    printf("strategy,distribution,ops,ns_per_op,mops_per_s,p50_ns,p99_ns,primes\n");
+    for (const Distribution& d : dists) {
+        for (const Strategy& s : strategies) bench(s, d, ops);
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+// make_prime_table.cpp
+// Writes the persistent prime table used by MappedPrimeTable (PrimeTable.h).
+//
+// Usage: make_prime_table [path] [limit]
+//   path  output file (default: primes32.bin)
+//   limit exclusive bound of the table (default: 2^32, about 143 MB)
+#include "PrimeTable.h"
+#include <iostream>
+#include <chrono>
+
+int main(int argc, char* argv[]) {
+    std::string path = argc > 1 ? argv[1] : "primes32.bin";
+
+    try {
+        uint64_t limit = PRIME_TABLE_DEFAULT_LIMIT;
+        if (argc > 2) {
+            std::string arg = argv[2];
+            if (arg.empty() || arg.find_first_not_of("0123456789") != std::string::npos) {
+                throw std::invalid_argument("limit is not a number: " + arg);
+            }
+            try {
+                limit = std::stoull(arg);
+            } catch (const std::out_of_range&) {
+                throw std::out_of_range("limit is above 2^64 - 1: " + arg);
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        write_prime_table(path, limit);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        MappedPrimeTable table(path); // read back to validate the file
+        std::cout << "Wrote " << path << ": " << table.prime_count() << " primes below "
+                  << table.limit() << " in " << seconds << " s" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,229 @@
+// test_primes.cpp
+#include "MillerRabin.h"
+#include "PrimeSieve.h"
+#include "PrimeBitmap.h"
+#include "PrimeBatch.h"
+#include "PrimeTable.h"
+#include "Factorize.h"
+#include "PrimePi.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+
+using namespace std;
+
+void print_test_result(const string& test_name, bool result) {
+    cout << "[" << (result ? "OK" : "FAIL") << "] " << test_name << endl;
+}
+
+// Reference: simple trial division
+bool is_prime_reference(uint64_t n) {
+    if (n < 2) return false;
+    for (uint64_t d = 2; d * d <= n; ++d) {
+        if (n % d == 0) return false;
+    }
+    return true;
+}
+
+void test_segmented_sieve() {
+    cout << "\n=== Segmented Sieve ===" << endl;
+
+    // Known values of pi(x)
+    print_test_result("T1: count_primes(0, 100) == 25", count_primes(0, 100) == 25);
+    print_test_result("T2: count_primes(0, 10^6) == 78498", count_primes(0, 1000000) == 78498);
+    print_test_result("T3: count_primes(0, 10^9) == 50847534", count_primes(0, 1000000000) == 50847534);
+
+    // Odd-sized range that crosses several segment boundaries, single vs. multi-threaded
+    uint64_t lo = 1000000000000ULL - 1234567, hi = 1000000000000ULL + 3456789;
+    uint64_t expected = 0;
+    for (uint64_t n = lo; n < hi; ++n) expected += isPrime_miller_rabin(n);
+    print_test_result("T4: count_primes around 10^12 matches Miller-Rabin",
+                      count_primes(lo, hi, 1) == expected && count_primes(lo, hi, 4) == expected);
+
+    // for_each_prime visits every prime exactly once in increasing order
+    vector<uint64_t> visited;
+    for_each_prime(0, 2000000, [&](uint64_t p) { visited.push_back(p); }, 4);
+    bool ok = visited.size() == 148933;
+    for (size_t i = 1; ok && i < visited.size(); ++i) ok = visited[i - 1] < visited[i];
+    for (size_t i = 0; ok && i < 1000; ++i) ok = is_prime_reference(visited[i]);
+    print_test_result("T5: for_each_prime(0, 2*10^6) ordered and complete", ok);
+
+    // Small and empty ranges
+    vector<uint64_t> small;
+    for_each_prime(2, 12, [&](uint64_t p) { small.push_back(p); });
+    print_test_result("T6: for_each_prime(2, 12) == {2, 3, 5, 7, 11}",
+                      small == vector<uint64_t>({2, 3, 5, 7, 11}));
+    print_test_result("T7: Empty ranges", count_primes(10, 10) == 0 && count_primes(24, 29) == 0);
+}
+
+void test_prime_bitmap() {
+    cout << "\n=== Compile-time Prime Bitmap ===" << endl;
+
+    bool ok = true;
+    for (uint32_t n = 0; ok && n < PRIME_BITMAP_LIMIT; ++n) ok = prime_bitmap_lookup(n) == isPrime_miller_rabin(n);
+    print_test_result("T1: Bitmap matches Miller-Rabin below PRIME_BITMAP_LIMIT", ok);
+
+    uint64_t counted = 0;
+    for (uint8_t byte : prime_wheel) counted += __builtin_popcount(byte);
+    counted += 3; // 2, 3 and 5 are not stored in the wheel
+    uint64_t tail = 0; // stored bits at or above the limit in the last byte
+    for (uint32_t n = PRIME_BITMAP_LIMIT; n < 30 * prime_wheel.size(); ++n) tail += prime_bitmap_lookup(n);
+    print_test_result("T2: Popcount of the wheel equals pi(PRIME_BITMAP_LIMIT)",
+                      counted - tail == count_primes(0, PRIME_BITMAP_LIMIT));
+}
+
+void test_prime_batch() {
+    cout << "\n=== Batched Primality Test ===" << endl;
+
+    // Mix of small values, random 64-bit values, primes near 2^64 and strong pseudoprimes
+    vector<uint64_t> values;
+    for (uint64_t n = 0; n < 20000; ++n) values.push_back(n);
+    mt19937_64 rng(42);
+    for (int i = 0; i < 20000; ++i) values.push_back(rng());
+    for (int i = 0; i < 20000; ++i) values.push_back(rng() >> (rng() % 64));
+    for (uint64_t n = 18446744073709551615ULL; n > 18446744073709550000ULL; --n) values.push_back(n);
+    uint64_t pseudoprimes[] = {2047, 1373653, 25326001, 3215031751ULL, 2152302898747ULL,
+                               3474749660383ULL, 341550071728321ULL, 3825123056546413051ULL};
+    for (uint64_t n : pseudoprimes) values.push_back(n);
+
+    vector<uint8_t> result = is_prime_batch(values);
+    bool ok = true;
+    for (size_t i = 0; ok && i < values.size(); ++i) ok = (result[i] != 0) == isPrime_miller_rabin(values[i]);
+    print_test_result("T1: is_prime_batch matches isPrime_miller_rabin", ok);
+
+    // Lengths that leave a partial SIMD block and a partial Miller-Rabin group
+    uint8_t out[7];
+    uint64_t in[7] = {2, 97, 101, 1000000007ULL, 1000000009ULL, 1000000011ULL, 18446744073709551557ULL};
+    is_prime_batch(in, out, 7);
+    print_test_result("T2: Partial batch of 7",
+                      out[0] && out[1] && out[2] && out[3] && out[4] && !out[5] && out[6]);
+}
+
+void test_mapped_prime_table() {
+    cout << "\n=== Memory-mapped Prime Table ===" << endl;
+
+    const string path = "test_primes_table.bin";
+    const uint64_t limit = 10000000;
+    write_prime_table(path, limit);
+    {
+        MappedPrimeTable table(path);
+        print_test_result("T1: Header round trip", table.limit() == limit && table.prime_count() == 664579);
+
+        bool ok = true;
+        for (uint64_t n = 0; ok && n < limit; ++n) ok = table.contains(n) == isPrime_miller_rabin(n);
+        print_test_result("T2: Table matches Miller-Rabin below 10^7", ok);
+        print_test_result("T3: Queries above the limit fall back to Miller-Rabin",
+                          table.isPrime(1000000007ULL) && !table.isPrime(1000000011ULL));
+    }
+
+    // A file with the wrong magic is rejected
+    FILE* f = fopen(path.c_str(), "r+b");
+    fputc('X', f);
+    fclose(f);
+    bool rejected = false;
+    try {
+        MappedPrimeTable table(path);
+    } catch (const runtime_error&) {
+        rejected = true;
+    }
+    print_test_result("T4: Corrupted header is rejected", rejected);
+
+    // A limit near 2^64 would make (limit + 29) / 30 wrap to 0 and pass the size check
+    write_prime_table(path, 1000);
+    PrimeTableHeader header;
+    f = fopen(path.c_str(), "r+b");
+    fread(&header, sizeof(header), 1, f);
+    header.limit = UINT64_MAX - 10;
+    header.data_size = 0;
+    fseek(f, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, f);
+    fclose(f);
+    rejected = false;
+    try {
+        MappedPrimeTable table(path);
+    } catch (const runtime_error&) {
+        rejected = true;
+    }
+    print_test_result("T5: Overflowing limit is rejected", rejected);
+    remove(path.c_str());
+}
+
+// True if the pairs are increasing primes whose product is n
+bool is_factorization_of(uint64_t n, const vector<pair<uint64_t, int>>& factors) {
+    unsigned __int128 product = 1;
+    for (size_t i = 0; i < factors.size(); ++i) {
+        if (!isPrime_miller_rabin(factors[i].first) || factors[i].second < 1) return false;
+        if (i > 0 && factors[i - 1].first >= factors[i].first) return false;
+        for (int k = 0; k < factors[i].second; ++k) product *= factors[i].first;
+    }
+    return product == n;
+}
+
+void test_factorize() {
+    cout << "\n=== Pollard-Brent Factorization ===" << endl;
+
+    print_test_result("T1: factorize(0) and factorize(1) are empty", factorize(0).empty() && factorize(1).empty());
+    print_test_result("T2: 360 = 2^3 * 3^2 * 5",
+                      factorize(360) == vector<pair<uint64_t, int>>({{2, 3}, {3, 2}, {5, 1}}));
+    print_test_result("T3: 2^64 - 1 = 3 * 5 * 17 * 257 * 641 * 65537 * 6700417",
+                      factorize(18446744073709551615ULL) ==
+                      vector<pair<uint64_t, int>>({{3, 1}, {5, 1}, {17, 1}, {257, 1}, {641, 1}, {65537, 1}, {6700417, 1}}));
+    print_test_result("T4: Square of the largest 32-bit prime",
+                      factorize(4294967291ULL * 4294967291ULL) == vector<pair<uint64_t, int>>({{4294967291ULL, 2}}));
+
+    // Random inputs and hard semiprimes (two ~32-bit prime factors)
+    mt19937_64 rng(7);
+    vector<uint64_t> inputs;
+    for (int i = 0; i < 2000; ++i) inputs.push_back(rng());
+    for (int i = 0; i < 500; ++i) {
+        uint64_t p = (rng() >> 32) | 0x80000000ULL, q = (rng() >> 32) | 0x80000000ULL;
+        while (!isPrime_miller_rabin(p)) ++p;
+        while (!isPrime_miller_rabin(q)) ++q;
+        inputs.push_back(p * q);
+    }
+    bool ok = true;
+    auto start = chrono::steady_clock::now();
+    for (uint64_t n : inputs) ok = ok && is_factorization_of(n, factorize(n));
+    double us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / inputs.size();
+    print_test_result("T5: Random and semiprime 64-bit inputs factor correctly", ok);
+    cout << "   Average time per factorization: " << us << " us" << endl;
+}
+
+void test_prime_pi() {
+    cout << "\n=== Meissel-Lehmer pi(x) ===" << endl;
+
+    print_test_result("T1: Small x from the compile-time bitmap",
+                      prime_pi(0) == 0 && prime_pi(1) == 0 && prime_pi(2) == 1 && prime_pi(100) == 25 &&
+                      prime_pi(1000000) == 78498);
+    print_test_result("T2: pi(10^9) == 50847534", prime_pi(1000000000ULL) == 50847534);
+    print_test_result("T3: pi(10^11) == 4118054813", prime_pi(100000000000ULL) == 4118054813ULL);
+
+    // Odd values of x agree with the segmented sieve, with and without threads
+    bool ok = true;
+    uint64_t xs[] = {1048575, 1048576, 1048577, 12345678, 987654321, 2147483647};
+    for (uint64_t x : xs) {
+        uint64_t expected = count_primes(0, x + 1);
+        ok = ok && prime_pi(x, 1) == expected && prime_pi(x, 4) == expected;
+    }
+    print_test_result("T4: prime_pi(x) matches count_primes(0, x + 1)", ok);
+
+    auto start = chrono::steady_clock::now();
+    bool big = prime_pi(1000000000000ULL) == 37607912018ULL;
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    print_test_result("T5: pi(10^12) == 37607912018", big);
+    cout << "   pi(10^12) computed in " << seconds << " s" << endl;
+}
+
+int main() {
+    test_segmented_sieve();
+    test_prime_bitmap();
+    test_prime_batch();
+    test_mapped_prime_table();
+    test_factorize();
+    test_prime_pi();
+
+    cout << "\nAll tests completed." << endl;
+    return 0;
+}
@@ -0,0 +1,190 @@
+#ifndef BLOCKING_QUEUE_H
+#define BLOCKING_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include "MpmcQueue.h"
+#if defined(__linux__)
+#include <cerrno>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+// Event count: lets a thread sleep until "something may have changed" without
+// losing wake-ups, and lets the notifier skip the system call when nobody sleeps.
+//
+// Waiter:   key = prepare_wait(); if (condition holds) cancel_wait(); else wait(key, ...);
+// Notifier: make the condition true; notify_one() / notify_all();
+//
+// prepare_wait() registers the waiter before it re-checks the condition, and the
+// notifier checks for waiters after changing the condition (both behind seq_cst
+// fences), so either the waiter sees the change or the notifier sees the waiter.
+// A notification bumps the epoch, so a wait() on an outdated key returns at once.
+class EventCount {
+public:
+ EventCount() : _epoch(0), _waiters(0) {}
+
+ EventCount(const EventCount&) = delete;
+ EventCount& operator=(const EventCount&) = delete;
+
+ uint32_t prepare_wait() {
+    _waiters.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return _epoch.load(std::memory_order_acquire);
+ }
+
+ void cancel_wait() { _waiters.fetch_sub(1, std::memory_order_relaxed); }
+
+ // Sleep until notified after prepare_wait() returned key, or until deadline
+ // Returns false on timeout (spurious returns are possible: re-check the condition)
+ bool wait(uint32_t key, std::chrono::steady_clock::time_point deadline) {
+    bool notified = true;
+    if (_epoch.load(std::memory_order_acquire) == key) {
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= remaining.zero()) {
+            notified = false;
+        } else {
+            notified = sleep(key, std::chrono::duration_cast<std::chrono::nanoseconds>(remaining));
+        }
+    }
+    _waiters.fetch_sub(1, std::memory_order_relaxed);
+    return notified;
+ }
+
+ void notify_one() { notify(1); }
+ void notify_all() { notify(INT32_MAX); }
+
+private:
+  std::atomic<uint32_t> _epoch; // incremented by every notification that found waiters
+  std::atomic<uint32_t> _waiters; // threads between prepare_wait() and the end of wait()
+
+  void notify(int count) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_waiters.load(std::memory_order_relaxed) == 0) return; // fast path: no system call
+    _epoch.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_epoch), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (count == 1) _cv.notify_one(); else _cv.notify_all();
+#endif
+  }
+
+#if defined(__linux__)
+  // The kernel re-checks _epoch == key atomically before sleeping
+  bool sleep(uint32_t key, std::chrono::nanoseconds timeout) {
+    timespec ts;
+    ts.tv_sec = (time_t)(timeout.count() / 1000000000);
+    ts.tv_nsec = (long)(timeout.count() % 1000000000);
+    long r = syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_epoch), FUTEX_WAIT_PRIVATE, key, &ts, nullptr, 0);
+    return !(r == -1 && errno == ETIMEDOUT);
+  }
+#else
+  std::mutex _mutex;
+  std::condition_variable _cv;
+
+  bool sleep(uint32_t key, std::chrono::nanoseconds timeout) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _cv.wait_for(lock, timeout, [&] { return _epoch.load(std::memory_order_acquire) != key; });
+  }
+#endif
+};
+
+
+// Class template for a bounded multi-producer/multi-consumer queue whose push and
+// pop wait instead of failing: the circular buffer is MpmcQueue, and a thread that
+// finds it full (push) or empty (pop) spins briefly, then sleeps on an EventCount.
+// Successful operations only enter the kernel when a thread is actually asleep.
+template <typename T>
+class BlockingQueue {
+public:
+ // Number of failed attempts (with a pause instruction between them) before sleeping
+ static const int SPIN_LIMIT = 128;
+
+ // Constructor: capacity is max_size rounded up to a power of two
+ explicit BlockingQueue(int max_size=1024) : _queue(max_size) {}
+
+ BlockingQueue(const BlockingQueue&) = delete;
+ BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+
+ // Non-blocking: return false when full / empty
+ bool try_push(const T& item) {
+    if (!_queue.try_enqueue(item)) return false;
+    _not_empty.notify_one();
+    return true;
+ }
+
+ bool try_pop(T& item) {
+    if (!_queue.try_dequeue(item)) return false;
+    _not_full.notify_one();
+    return true;
+ }
+
+ // Blocking: wait as long as needed
+ void push(const T& item) {
+    push_until(item, std::chrono::steady_clock::time_point::max());
+ }
+
+ T pop() {
+    T item{};
+    pop_until(item, std::chrono::steady_clock::time_point::max());
+    return item;
+ }
+
+ // Timed: wait at most timeout; return false if it expired
+ template <typename Rep, typename Period>
+ bool push_for(const T& item, const std::chrono::duration<Rep, Period>& timeout) {
+    return push_until(item, std::chrono::steady_clock::now() + timeout);
+ }
+
+ template <typename Rep, typename Period>
+ bool pop_for(T& item, const std::chrono::duration<Rep, Period>& timeout) {
+    return pop_until(item, std::chrono::steady_clock::now() + timeout);
+ }
+
+ bool push_until(const T& item, std::chrono::steady_clock::time_point deadline) {
+    return wait_for([&] { return try_push(item); }, _not_full, deadline);
+ }
+
+ bool pop_until(T& item, std::chrono::steady_clock::time_point deadline) {
+    return wait_for([&] { return try_pop(item); }, _not_empty, deadline);
+ }
+
+ // Observers (only a snapshot while other threads are running)
+ int size() const { return _queue.size(); }
+ bool empty() const { return _queue.empty(); }
+ int max_size() const { return _queue.max_size(); }
+
+private:
+  MpmcQueue<T> _queue;
+  EventCount _not_empty; // pop() sleeps here, signalled by each successful push
+  EventCount _not_full; // push() sleeps here, signalled by each successful pop
+
+  template <typename Attempt>
+  static bool wait_for(Attempt attempt, EventCount& event, std::chrono::steady_clock::time_point deadline) {
+    for (int spins = 0; spins < SPIN_LIMIT; ++spins) {
+        if (attempt()) return true;
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+    for (;;) {
+        uint32_t key = event.prepare_wait();
+        if (attempt()) {
+            event.cancel_wait();
+            return true;
+        }
+        if (!event.wait(key, deadline)) return attempt(); // one last try after a timeout
+    }
+  }
+};
+
+#endif // BLOCKING_QUEUE_H
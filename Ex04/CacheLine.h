@@ -0,0 +1,10 @@
+#ifndef CACHE_LINE_H
+#define CACHE_LINE_H
+
+#include <cstddef>
+
+// Size of a cache line: fields written by different threads are kept this far apart
+// to avoid false sharing
+const size_t CACHE_LINE_SIZE = 64;
+
+#endif // CACHE_LINE_H
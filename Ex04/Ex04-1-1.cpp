@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <cstdlib> // For exit()
+#include <cstring> // For memcpy()
 
 // Define a struct for representing three dimensional points with integral coordinates 
 struct Point {
@@ -11,6 +12,20 @@ struct Point {
     int z; // Z-coordinate
 };
 
+// A contiguous run of Points inside the queue's storage (read-only view)
+struct PointSpan {
+    const Point* data; // first element of the run
+    int size; // number of elements in the run
+};
+
+// The ready region of the queue, in FIFO order: first, then second.
+// second is empty unless the region wraps around the end of the array.
+struct PointSpans {
+    PointSpan first;
+    PointSpan second;
+    int size() const { return first.size + second.size; }
+};
+
 
 // Class for representing a queue implemented using a circular array
 class Queue {
@@ -56,6 +71,22 @@ public:
  // Also returns a const Point& for safety (prevents external modification of queue contents via the return value)
  const Point& peek() const;
 
+
+ // Bulk interface: each call does one capacity check and at most two memcpy,
+ // instead of one check and one modulo per element
+
+ // Insert n elements from items, in order
+ // Print an error message on std::cerr and exit if they do not all fit (nothing is inserted)
+ void enqueue_bulk(const Point* items, int n);
+
+ // Remove the n least recently added elements, copying them to out (skipped if out is nullptr)
+ // Print an error message on std::cerr and exit if fewer than n elements are queued
+ void dequeue_bulk(Point* out, int n);
+
+ // Zero-copy view of all queued elements as at most two contiguous spans
+ // Valid until the next modification; consume with dequeue_bulk(nullptr, n)
+ PointSpans peek_span() const;
+
 private:
   int _num_items; // number of elements currently in the queue
   int _max_size; // capacity of the fixed-size queue
@@ -1,4 +1,5 @@
 #include "Ex04-1-1.cpp" // Include the header definitions
+#include <algorithm> // For std::min()
 
 // Checks if the queue is empty.
 bool Queue::empty() const {
@@ -47,3 +48,44 @@ const Point& Queue::peek() const {
     
     return _items[_first]; // Returns a const reference
 }
+
+// Inserts n Points at the back of the queue.
+void Queue::enqueue_bulk(const Point* items, int n) {
+    if (n < 0 || n > _max_size - _num_items) {
+        std::cerr << "Error: Queue overflow. Cannot enqueue " << n << " items." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (n == 0) return;
+
+    // Up to the end of the array, then the rest from index 0
+    int head = std::min(n, _max_size - _last);
+    std::memcpy(_items + _last, items, head * sizeof(Point));
+    std::memcpy(_items, items + head, (n - head) * sizeof(Point));
+    _last = (_last + n) % _max_size;
+    _num_items += n;
+}
+
+// Removes n Points from the front of the queue, copying them to out if it is not null.
+void Queue::dequeue_bulk(Point* out, int n) {
+    if (n < 0 || n > _num_items) {
+        std::cerr << "Error: Queue underflow. Cannot dequeue " << n << " items." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (out && n > 0) {
+        int head = std::min(n, _max_size - _first);
+        std::memcpy(out, _items + _first, head * sizeof(Point));
+        std::memcpy(out + head, _items, (n - head) * sizeof(Point));
+    }
+    _first = (_first + n) % _max_size;
+    _num_items -= n;
+}
+
+// Returns the queued elements as (at most) two contiguous spans of the array.
+PointSpans Queue::peek_span() const {
+    int head = std::min(_num_items, _max_size - _first);
+    PointSpans spans;
+    spans.first = PointSpan{_items + _first, head};
+    spans.second = PointSpan{_items, _num_items - head};
+    return spans;
+}
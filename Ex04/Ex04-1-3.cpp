@@ -67,6 +67,26 @@ int main(void) {
     
     std::cout << "Final size: " << const_q.size() << ", Empty: " << (const_q.empty() ? "Yes" : "No") << std::endl;
 
+    // 5. Bulk operations across the wrap-around
+    std::cout << "\n--- 5. Bulk Enqueue/Dequeue and Spans ---" << std::endl;
+    Point batch[TEST_SIZE] = {p1, p2, p3, p4};
+    q.enqueue_bulk(batch, 3); // Head is at index 1 after five dequeues: fills indices 1..3
+    PointSpans spans = const_q.peek_span();
+    std::cout << "Spans before wrap-around: " << spans.first.size << " + " << spans.second.size
+              << " (Expected: 3 + 0)" << std::endl;
+    q.dequeue_bulk(nullptr, 1); // Drop P1
+    q.enqueue_bulk(batch + 3, 1); // P4 goes to index 0
+    spans = const_q.peek_span();
+    std::cout << "Spans after wrap-around: " << spans.first.size << " + " << spans.second.size
+              << " (Expected: 2 + 1)" << std::endl;
+
+    Point out[TEST_SIZE];
+    q.dequeue_bulk(out, 3);
+    std::cout << "Bulk dequeued (Expected P2, P3, P4): ";
+    for (int i = 0; i < 3; ++i) { print_point(out[i]); std::cout << " "; }
+    std::cout << std::endl;
+    std::cout << "Final size: " << const_q.size() << ", Empty: " << (const_q.empty() ? "Yes" : "No") << std::endl;
+
     std::cout << "\nAll const-correctness tests completed successfully." << std::endl;
     
     return 0;
@@ -0,0 +1,78 @@
+#ifndef FIXED_QUEUE_H
+#define FIXED_QUEUE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <cstdlib> // For exit()
+
+// Class template for a queue with compile-time capacity, stored inline (no heap allocation)
+// Capacity must be a power of two: indices grow monotonically and are mapped to
+// slots with a bit mask, so no modulo (integer division) is needed on enqueue/dequeue.
+template <typename T, size_t Capacity>
+class FixedQueue {
+ static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+               "FixedQueue capacity must be a power of two");
+ static_assert(Capacity <= (size_t(1) << 30),
+               "FixedQueue capacity must fit in an int");
+
+public:
+ // Constructor: no allocation, the storage is part of the object
+ FixedQueue() : _first(0), _last(0) {}
+
+ // Interface (same semantics as Queue in Ex04-1-1.cpp)
+
+ // Check whether the queue is empty
+ bool empty() const { return _first == _last; }
+
+ // Check whether the queue is full
+ bool full() const { return size() == (int)Capacity; }
+
+ // Return the number of elements in the queue
+ // Unsigned subtraction stays correct when the indices wrap around 2^32
+ int size() const { return (int)(_last - _first); }
+
+ // Capacity of the queue
+ static constexpr int max_size() { return (int)Capacity; }
+
+ // Insert an element in the queue (Enqueue)
+ // Print an error message on std::cerr and exit in case of overflow
+ void enqueue(const T& item) {
+    if (full()) {
+        std::cerr << "Error: Queue overflow. Cannot enqueue item." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    _items[_last & MASK] = item;
+    ++_last;
+ }
+
+ // Remove an element from the queue (Dequeue)
+ // Print an error message on std::cerr and exit in case of underflow
+ void dequeue() {
+    if (empty()) {
+        std::cerr << "Error: Queue underflow. Cannot dequeue from empty queue." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    ++_first;
+ }
+
+ // Access the least recently added element (Peek)
+ // Print an error message on std::cerr and exit in case of underflow
+ const T& peek() const {
+    if (empty()) {
+        std::cerr << "Error: Queue underflow. Cannot peek into empty queue." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return _items[_first & MASK];
+ }
+
+private:
+  static constexpr uint32_t MASK = (uint32_t)(Capacity - 1);
+
+  uint32_t _first; // monotonically increasing index of the first element (Head)
+  uint32_t _last; // monotonically increasing index of the next available slot (Tail)
+  std::array<T, Capacity> _items; // data container (circular array, inline)
+};
+
+#endif // FIXED_QUEUE_H
@@ -0,0 +1,134 @@
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include "CacheLine.h"
+
+// Class template for a bounded lock-free multi-producer/multi-consumer queue
+// (D. Vyukov's bounded MPMC queue). Any number of threads may enqueue and dequeue.
+//
+// Every slot carries a sequence number telling whose turn it is:
+//   sequence == pos       the slot is free for the producer that claims position pos
+//   sequence == pos + 1   the slot holds the element for the consumer of position pos
+// A thread claims a position with one compare-and-swap on the shared counter and
+// then owns the slot; the release store of the new sequence publishes the element.
+// Producers and consumers only contend among themselves, never on a common lock.
+template <typename T>
+class MpmcQueue {
+public:
+ // Constructor: capacity is max_size rounded up to a power of two (at least 2)
+ explicit MpmcQueue(int max_size=1024) : _enqueue_pos(0), _dequeue_pos(0) {
+    uint64_t capacity = 2;
+    while (capacity < (uint64_t)(max_size > 0 ? max_size : 1)) capacity <<= 1;
+    _mask = capacity - 1;
+    _slots = new Slot[capacity];
+    for (uint64_t i = 0; i < capacity; ++i) _slots[i].sequence.store(i, std::memory_order_relaxed);
+ }
+
+ ~MpmcQueue() { delete[] _slots; }
+
+ // Prevent copy and move operations
+ MpmcQueue(const MpmcQueue&) = delete;
+ MpmcQueue& operator=(const MpmcQueue&) = delete;
+ MpmcQueue(MpmcQueue&&) = delete;
+ MpmcQueue& operator=(MpmcQueue&&) = delete;
+
+ // Insert an element if there is room; returns false (and changes nothing) when full
+ bool try_enqueue(const T& item) {
+    uint64_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = _slots[pos & _mask];
+        uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+        int64_t diff = (int64_t)(seq - pos);
+        if (diff == 0) {
+            // Slot free: claim the position (pos is reloaded on failure)
+            if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.item = item;
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // the consumer of the previous round has not freed it: full
+        } else {
+            pos = _enqueue_pos.load(std::memory_order_relaxed); // another producer won
+        }
+    }
+ }
+
+ // Remove the least recently added element into item; returns false when empty
+ bool try_dequeue(T& item) {
+    uint64_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = _slots[pos & _mask];
+        uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+        int64_t diff = (int64_t)(seq - (pos + 1));
+        if (diff == 0) {
+            if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                item = slot.item;
+                // Free the slot for the producer one round later
+                slot.sequence.store(pos + _mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // not written yet: empty
+        } else {
+            pos = _dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+ }
+
+ // Insert an element, waiting while the queue is full
+ void enqueue(const T& item) {
+    for (unsigned spins = 0; !try_enqueue(item); ++spins) backoff(spins);
+ }
+
+ // Remove the least recently added element, waiting while the queue is empty
+ T dequeue() {
+    T item;
+    for (unsigned spins = 0; !try_dequeue(item); ++spins) backoff(spins);
+    return item;
+ }
+
+ // Number of elements (only a snapshot while other threads are running)
+ int size() const {
+    uint64_t head = _dequeue_pos.load(std::memory_order_acquire);
+    uint64_t tail = _enqueue_pos.load(std::memory_order_acquire);
+    return tail > head ? (int)(tail - head) : 0;
+ }
+
+ // Check whether the queue is empty (same caveat as size())
+ bool empty() const { return size() == 0; }
+
+ // Capacity of the queue
+ int max_size() const { return (int)(_mask + 1); }
+
+private:
+  struct Slot {
+    std::atomic<uint64_t> sequence;
+    T item;
+  };
+
+  // Busy-wait briefly, then give the core away (the other side may share it)
+  static void backoff(unsigned spins) {
+    if (spins < 64) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    } else {
+        std::this_thread::yield();
+    }
+  }
+
+  // Producer and consumer counters on their own cache lines
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> _enqueue_pos; // next position to write (Tail)
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> _dequeue_pos; // next position to read (Head)
+
+  // Read-only after construction
+  alignas(CACHE_LINE_SIZE) uint64_t _mask; // capacity - 1
+  Slot* _slots; // data container (circular array)
+};
+
+#endif // MPMC_QUEUE_H
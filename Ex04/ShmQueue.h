@@ -0,0 +1,261 @@
+#ifndef SHM_QUEUE_H
+#define SHM_QUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib> // For exit()
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Ex04-1-1.cpp" // Point
+#include "CacheLine.h"
+
+// Single-producer/single-consumer queue of Points in a POSIX shared-memory segment,
+// so a producer process and a consumer process exchange Points without a pipe:
+// enqueue writes the Point straight into the ring, dequeue reads it from there.
+// (Link with -lrt on glibc older than 2.34.)
+//
+// Segment layout (native struct layout, same machine only):
+//   ShmQueueHeader: identification, then head and tail on their own cache lines
+//   Point[capacity] at header.items_offset
+// Nothing in the segment is a pointer: each process maps it at its own address and
+// locates the ring from the offset, so the layout is position independent.
+//
+// Crash safety: the segment is created and (re)initialized under an exclusive
+// flock() on the shared-memory file. The header is marked ready only after it has
+// been fully written, and the kernel drops the lock if the initializing process dies.
+// So a half-initialized segment is detected and rebuilt by the next process that
+// attaches. After a producer or consumer crash the survivor can call reinitialize()
+// to discard the ring's contents.
+
+const char SHM_QUEUE_MAGIC[8] = {'P', 'T', 'S', 'H', 'M', 'Q', 'U', 'E'};
+const uint32_t SHM_QUEUE_VERSION = 1;
+
+struct ShmQueueHeader {
+    char magic[8];                 // SHM_QUEUE_MAGIC, written last by initialization
+    uint32_t version;              // SHM_QUEUE_VERSION
+    uint32_t element_size;         // sizeof(Point)
+    uint64_t capacity;             // ring size, a power of two
+    uint64_t items_offset;         // offset of the ring from the start of the segment
+    std::atomic<uint32_t> generation; // incremented by every (re)initialization
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head; // written by the consumer
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail; // written by the producer
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Shared-memory indices must be lock-free atomics");
+
+class ShmQueue {
+public:
+ // Opens the segment called name (e.g. "/points"), creating it with room for
+ // max_size Points (rounded up to a power of two) if it does not exist or is not
+ // a valid queue. Throws std::runtime_error if the system calls fail or an existing
+ // queue has a different capacity.
+ ShmQueue(const std::string& name, int max_size) : _name(name) {
+    uint64_t capacity = 1;
+    while (capacity < (uint64_t)(max_size > 0 ? max_size : 1)) capacity <<= 1;
+    map(O_CREAT, capacity);
+ }
+
+ // Attaches to an existing queue; throws std::runtime_error if there is none
+ explicit ShmQueue(const std::string& name) : _name(name) {
+    map(0, 0);
+ }
+
+ ~ShmQueue() { detach(); }
+
+ // Prevent copy and move operations
+ ShmQueue(const ShmQueue&) = delete;
+ ShmQueue& operator=(const ShmQueue&) = delete;
+ ShmQueue(ShmQueue&&) = delete;
+ ShmQueue& operator=(ShmQueue&&) = delete;
+
+ // Unmaps the segment; the queue and its contents stay for the other process
+ void detach() {
+    if (_header) munmap(_header, _mapped_size);
+    if (_fd >= 0) close(_fd);
+    _header = nullptr;
+    _items = nullptr;
+    _fd = -1;
+ }
+
+ bool attached() const { return _header != nullptr; }
+
+ // Removes the name; processes still attached keep their mapping
+ static void unlink(const std::string& name) { shm_unlink(name.c_str()); }
+
+ // Empties the ring (e.g. after the peer process crashed mid-stream)
+ // Neither side may be inside an operation while this runs.
+ void reinitialize() {
+    lock();
+    _header->head.store(0, std::memory_order_relaxed);
+    _header->tail.store(0, std::memory_order_relaxed);
+    _header->generation.fetch_add(1, std::memory_order_release);
+    unlock();
+ }
+
+ uint32_t generation() const { return _header->generation.load(std::memory_order_acquire); }
+
+
+ // Producer interface (one process)
+
+ // Insert an element if there is room; returns false (and changes nothing) when full
+ bool try_enqueue(const Point& p) {
+    uint64_t tail = _header->tail.load(std::memory_order_relaxed);
+    if (tail - _header->head.load(std::memory_order_acquire) > _mask) return false;
+    _items[tail & _mask] = p;
+    _header->tail.store(tail + 1, std::memory_order_release);
+    return true;
+ }
+
+ // Insert an element in the queue (Enqueue)
+ // Print an error message on std::cerr and exit in case of overflow
+ void enqueue(const Point& p) {
+    if (!try_enqueue(p)) {
+        std::cerr << "Error: Queue overflow. Cannot enqueue item." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+ }
+
+
+ // Consumer interface (one process)
+
+ // Pointer into the shared ring to the least recently added element, nullptr when empty
+ const Point* try_peek() const {
+    uint64_t head = _header->head.load(std::memory_order_relaxed);
+    if (head == _header->tail.load(std::memory_order_acquire)) return nullptr;
+    return &_items[head & _mask];
+ }
+
+ // Remove the least recently added element into p; returns false when empty
+ bool try_dequeue(Point& p) {
+    const Point* front = try_peek();
+    if (!front) return false;
+    p = *front;
+    advance_head();
+    return true;
+ }
+
+ // Access the least recently added element (Peek)
+ // Print an error message on std::cerr and exit in case of underflow
+ const Point& peek() const {
+    const Point* front = try_peek();
+    if (!front) {
+        std::cerr << "Error: Queue underflow. Cannot peek into empty queue." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return *front;
+ }
+
+ // Remove an element from the queue (Dequeue)
+ // Print an error message on std::cerr and exit in case of underflow
+ void dequeue() {
+    peek(); // exits when empty
+    advance_head();
+ }
+
+
+ // Observers (either process; only a snapshot while the other side is running)
+
+ bool empty() const { return size() == 0; }
+
+ int size() const {
+    uint64_t head = _header->head.load(std::memory_order_acquire);
+    uint64_t tail = _header->tail.load(std::memory_order_acquire);
+    return tail > head ? (int)(tail - head) : 0;
+ }
+
+ int max_size() const { return (int)(_mask + 1); }
+
+private:
+  std::string _name;
+  int _fd = -1;
+  ShmQueueHeader* _header = nullptr;
+  Point* _items = nullptr; // this process's address of the ring
+  size_t _mapped_size = 0;
+  uint64_t _mask = 0;
+
+  // Only the consumer writes head: a plain store is enough
+  void advance_head() {
+    _header->head.store(_header->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  static uint64_t items_offset() {
+    return (sizeof(ShmQueueHeader) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+  }
+
+  void lock() {
+    if (flock(_fd, LOCK_EX) != 0) fail("Cannot lock shared memory");
+  }
+
+  void unlock() { flock(_fd, LOCK_UN); }
+
+  [[noreturn]] void fail(const std::string& what) {
+    std::string message = what + ": " + _name;
+    if (_fd >= 0) unlock();
+    detach();
+    throw std::runtime_error(message);
+  }
+
+  bool valid(const ShmQueueHeader* h, size_t file_size) const {
+    return std::memcmp(h->magic, SHM_QUEUE_MAGIC, sizeof(h->magic)) == 0 &&
+           h->version == SHM_QUEUE_VERSION && h->element_size == sizeof(Point) &&
+           h->capacity > 0 && (h->capacity & (h->capacity - 1)) == 0 &&
+           h->items_offset == items_offset() &&
+           file_size == h->items_offset + h->capacity * sizeof(Point);
+  }
+
+  // Opens (creating with O_CREAT) and maps the segment, initializing it if needed
+  void map(int create, uint64_t capacity) {
+    _fd = shm_open(_name.c_str(), O_RDWR | create, 0600);
+    if (_fd < 0) throw std::runtime_error("Cannot open shared memory: " + _name);
+    lock();
+
+    struct stat st;
+    if (fstat(_fd, &st) != 0) fail("Cannot stat shared memory");
+    size_t size = (size_t)st.st_size;
+    bool ready = size >= sizeof(ShmQueueHeader);
+    if (ready) {
+        void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+        if (base == MAP_FAILED) fail("Cannot map shared memory");
+        _header = static_cast<ShmQueueHeader*>(base);
+        _mapped_size = size;
+        ready = valid(_header, size);
+        if (ready && capacity != 0 && _header->capacity != capacity) fail("Shared queue has a different capacity");
+        if (!ready) {
+            munmap(base, size);
+            _header = nullptr;
+        }
+    }
+
+    if (!ready) {
+        // New segment, or one left behind by a crash during initialization
+        if (capacity == 0) fail("No valid shared queue");
+        size = items_offset() + capacity * sizeof(Point);
+        if (ftruncate(_fd, 0) != 0 || ftruncate(_fd, (off_t)size) != 0) fail("Cannot size shared memory");
+        void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+        if (base == MAP_FAILED) fail("Cannot map shared memory");
+        _header = static_cast<ShmQueueHeader*>(base); // zero-filled by ftruncate
+        _mapped_size = size;
+        _header->version = SHM_QUEUE_VERSION;
+        _header->element_size = sizeof(Point);
+        _header->capacity = capacity;
+        _header->items_offset = items_offset();
+        _header->generation.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(_header->magic, SHM_QUEUE_MAGIC, sizeof(_header->magic));
+    }
+    unlock();
+
+    _mask = _header->capacity - 1;
+    _items = reinterpret_cast<Point*>(reinterpret_cast<char*>(_header) + _header->items_offset);
+  }
+};
+
+#endif // SHM_QUEUE_H
@@ -0,0 +1,280 @@
+#ifndef SOA_QUEUE_H
+#define SOA_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib> // For exit(), aligned_alloc(), free()
+#include <climits>
+#include <iostream>
+#include <algorithm>
+#include <new>       // For std::bad_alloc
+#include <stdexcept> // For std::length_error
+#include "Ex04-1-1.cpp" // Point
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Axis-aligned bounding box of a set of Points (inclusive bounds)
+struct BoundingBox {
+    Point min;
+    Point max;
+};
+
+// Coordinate sums, widened so that they cannot overflow
+struct PointSum {
+    int64_t x;
+    int64_t y;
+    int64_t z;
+};
+
+// Mean position of a set of Points
+struct Centroid {
+    double x;
+    double y;
+    double z;
+};
+
+// Queue of Points stored as a structure of arrays (circular arrays x[], y[], z[])
+// Same interface and error handling as Queue in Ex04-1-1.cpp, plus reductions over
+// the whole current contents. Each coordinate array is 32-byte aligned so the
+// reductions can load 8 coordinates at a time (AVX2 when compiled with -mavx2,
+// scalar otherwise). The queued window is at most two contiguous runs (before and
+// after the wrap-around); every reduction processes both runs.
+class SoaQueue {
+public:
+ // Constructor: capacity is max_size rounded up to a power of two (at least 8)
+ // Throws std::length_error if max_size is above MAX_CAPACITY and std::bad_alloc if
+ // the arrays cannot be allocated
+ explicit SoaQueue(int max_size=1024)
+ : _num_items(0), _first(0), _last(0), _x(nullptr), _y(nullptr), _z(nullptr) {
+    if (max_size > MAX_CAPACITY) throw std::length_error("SoaQueue: capacity above 2^30");
+    _max_size = 8;
+    while (_max_size < max_size) _max_size <<= 1;
+    size_t bytes = (size_t)_max_size * sizeof(int);
+    _x = static_cast<int*>(std::aligned_alloc(ALIGNMENT, bytes));
+    _y = static_cast<int*>(std::aligned_alloc(ALIGNMENT, bytes));
+    _z = static_cast<int*>(std::aligned_alloc(ALIGNMENT, bytes));
+    if (!_x || !_y || !_z) {
+        std::free(_x);
+        std::free(_y);
+        std::free(_z);
+        throw std::bad_alloc();
+    }
+ }
+
+ // Largest capacity: the next power of two would overflow int
+ static const int MAX_CAPACITY = 1 << 30;
+
+ ~SoaQueue() {
+    std::free(_x);
+    std::free(_y);
+    std::free(_z);
+ }
+
+ // Prevent copy and move operations
+ SoaQueue(const SoaQueue&) = delete;
+ SoaQueue& operator=(const SoaQueue&) = delete;
+ SoaQueue(SoaQueue&&) = delete;
+ SoaQueue& operator=(SoaQueue&&) = delete;
+
+
+ // Interface
+
+ // Check whether the queue is empty
+ bool empty() const { return _num_items == 0; }
+
+ // Check whether the queue is full
+ bool full() const { return _num_items == _max_size; }
+
+ // Return the number of elements in the queue
+ int size() const { return _num_items; }
+
+ // Capacity of the queue
+ int max_size() const { return _max_size; }
+
+ // Insert an element in the queue (Enqueue)
+ // Print an error message on std::cerr and exit in case of overflow
+ void enqueue(const Point& p) {
+    if (full()) {
+        std::cerr << "Error: Queue overflow. Cannot enqueue item." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    _x[_last] = p.x;
+    _y[_last] = p.y;
+    _z[_last] = p.z;
+    _last = (_last + 1) & (_max_size - 1);
+    _num_items++;
+ }
+
+ // Remove an element from the queue (Dequeue)
+ // Print an error message on std::cerr and exit in case of underflow
+ void dequeue() {
+    check_not_empty("dequeue from");
+    _first = (_first + 1) & (_max_size - 1);
+    _num_items--;
+ }
+
+ // Copy of the least recently added element (Peek); the coordinates are not
+ // stored together, so there is no Point to return a reference to
+ // Print an error message on std::cerr and exit in case of underflow
+ Point peek() const {
+    check_not_empty("peek into");
+    return Point{_x[_first], _y[_first], _z[_first]};
+ }
+
+
+ // Reductions over all queued elements
+
+ // Componentwise minimum and maximum
+ // Print an error message on std::cerr and exit if the queue is empty
+ BoundingBox bounding_box() const {
+    check_not_empty("compute the bounding box of");
+    BoundingBox box;
+    min_max(_x, box.min.x, box.max.x);
+    min_max(_y, box.min.y, box.max.y);
+    min_max(_z, box.min.z, box.max.z);
+    return box;
+ }
+
+ // Componentwise sum (all zero for an empty queue)
+ PointSum sum() const {
+    return PointSum{sum(_x), sum(_y), sum(_z)};
+ }
+
+ // Mean position
+ // Print an error message on std::cerr and exit if the queue is empty
+ Centroid centroid() const {
+    check_not_empty("compute the centroid of");
+    PointSum s = sum();
+    return Centroid{(double)s.x / _num_items, (double)s.y / _num_items, (double)s.z / _num_items};
+ }
+
+ // Copy the elements with lo <= coordinate <= hi on the given axis (0 = x, 1 = y, 2 = z)
+ // to out, in FIFO order; returns how many were copied. out needs room for size() elements.
+ int filter(int axis, int lo, int hi, Point* out) const {
+    const int* key = axis == 0 ? _x : axis == 1 ? _y : _z;
+    int count = 0;
+    for (const Run& r : runs()) {
+        for_each_in_range(key, r, lo, hi, [&](int i) {
+            out[count++] = Point{_x[i], _y[i], _z[i]};
+        });
+    }
+    return count;
+ }
+
+ // Number of elements with lo <= coordinate <= hi on the given axis
+ int count_in_range(int axis, int lo, int hi) const {
+    const int* key = axis == 0 ? _x : axis == 1 ? _y : _z;
+    int count = 0;
+    for (const Run& r : runs()) {
+        for_each_in_range(key, r, lo, hi, [&](int) { ++count; });
+    }
+    return count;
+ }
+
+private:
+  static const size_t ALIGNMENT = 32; // one AVX2 register
+
+  // Contiguous index range [begin, end) of the storage
+  struct Run {
+    int begin;
+    int end;
+  };
+
+  int _num_items; // number of elements currently in the queue
+  int _max_size; // capacity of the queue (power of two)
+  int _first; // index to the first element of the queue (Head)
+  int _last; // index of the next available slot (Tail)
+  int* _x; // X-coordinates (circular array)
+  int* _y; // Y-coordinates (circular array)
+  int* _z; // Z-coordinates (circular array)
+
+  void check_not_empty(const char* what) const {
+    if (empty()) {
+        std::cerr << "Error: Queue underflow. Cannot " << what << " empty queue." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+  }
+
+  // The queued elements as two runs; the second is empty unless the window wraps
+  struct Runs {
+    Run r[2];
+    const Run* begin() const { return r; }
+    const Run* end() const { return r + 2; }
+  };
+  Runs runs() const {
+    int head = std::min(_num_items, _max_size - _first);
+    return Runs{{Run{_first, _first + head}, Run{0, _num_items - head}}};
+  }
+
+  void min_max(const int* a, int& lo, int& hi) const {
+    lo = INT_MAX;
+    hi = INT_MIN;
+    for (const Run& r : runs()) {
+        int i = r.begin;
+#if defined(__AVX2__)
+        if (r.end - i >= 8) {
+            __m256i vlo = _mm256_set1_epi32(INT_MAX), vhi = _mm256_set1_epi32(INT_MIN);
+            for (; i + 8 <= r.end; i += 8) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                vlo = _mm256_min_epi32(vlo, v);
+                vhi = _mm256_max_epi32(vhi, v);
+            }
+            alignas(32) int l[8], h[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(l), vlo);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(h), vhi);
+            for (int k = 0; k < 8; ++k) {
+                lo = std::min(lo, l[k]);
+                hi = std::max(hi, h[k]);
+            }
+        }
+#endif
+        for (; i < r.end; ++i) {
+            lo = std::min(lo, a[i]);
+            hi = std::max(hi, a[i]);
+        }
+    }
+  }
+
+  int64_t sum(const int* a) const {
+    int64_t total = 0;
+    for (const Run& r : runs()) {
+        int i = r.begin;
+#if defined(__AVX2__)
+        // Sign-extend to 64-bit lanes before adding: 32-bit lanes could overflow
+        __m256i acc = _mm256_setzero_si256();
+        for (; i + 8 <= r.end; i += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        }
+        alignas(32) int64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        total += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+        for (; i < r.end; ++i) total += a[i];
+    }
+    return total;
+  }
+
+  // Calls f(i) for every index i of the run with lo <= key[i] <= hi, in order
+  template <typename F>
+  static void for_each_in_range(const int* key, const Run& r, int lo, int hi, F f) {
+    int i = r.begin;
+#if defined(__AVX2__)
+    // lo <= v <= hi  <=>  !(v < lo) && !(v > hi); one bit per lane from movemask
+    __m256i vlo = _mm256_set1_epi32(lo), vhi = _mm256_set1_epi32(hi);
+    for (; i + 8 <= r.end; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key + i));
+        __m256i out = _mm256_or_si256(_mm256_cmpgt_epi32(vlo, v), _mm256_cmpgt_epi32(v, vhi));
+        unsigned mask = ~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(out)) & 0xFF;
+        for (; mask; mask &= mask - 1) f(i + __builtin_ctz(mask));
+    }
+#endif
+    for (; i < r.end; ++i) {
+        if (key[i] >= lo && key[i] <= hi) f(i);
+    }
+  }
+};
+
+#endif // SOA_QUEUE_H
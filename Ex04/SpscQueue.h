@@ -0,0 +1,133 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <cstdlib> // For exit()
+#include "CacheLine.h"
+
+// Class template for a lock-free single-producer/single-consumer queue (circular array)
+// Exactly one thread may call the producer functions (enqueue, try_enqueue) and
+// exactly one other thread the consumer functions (peek, dequeue, try_dequeue).
+//
+// The head is written only by the consumer and the tail only by the producer, each
+// on its own cache line and published with release stores / read with acquire loads.
+// Each side also keeps a private copy of the other side's index and only reloads it
+// when the queue looks full (producer) or empty (consumer), so in steady state the
+// two cores do not exchange cache lines on every operation.
+template <typename T>
+class SpscQueue {
+public:
+ // Constructor: capacity is max_size rounded up to a power of two
+ explicit SpscQueue(int max_size=1024) : _head(0), _tail_cache(0), _tail(0), _head_cache(0) {
+    uint64_t capacity = 1;
+    while (capacity < (uint64_t)(max_size > 0 ? max_size : 1)) capacity <<= 1;
+    _mask = capacity - 1;
+    _items = new T[capacity];
+ }
+
+ ~SpscQueue() { delete[] _items; }
+
+ // Prevent copy and move operations
+ SpscQueue(const SpscQueue&) = delete;
+ SpscQueue& operator=(const SpscQueue&) = delete;
+ SpscQueue(SpscQueue&&) = delete;
+ SpscQueue& operator=(SpscQueue&&) = delete;
+
+
+ // Producer interface
+
+ // Insert an element if there is room; returns false (and changes nothing) when full
+ bool try_enqueue(const T& item) {
+    uint64_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _head_cache > _mask) {
+        _head_cache = _head.load(std::memory_order_acquire);
+        if (tail - _head_cache > _mask) return false;
+    }
+    _items[tail & _mask] = item;
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+ }
+
+ // Insert an element in the queue (Enqueue)
+ // Print an error message on std::cerr and exit in case of overflow
+ void enqueue(const T& item) {
+    if (!try_enqueue(item)) {
+        std::cerr << "Error: Queue overflow. Cannot enqueue item." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+ }
+
+
+ // Consumer interface
+
+ // Remove the least recently added element into item; returns false when empty
+ bool try_dequeue(T& item) {
+    const T* front = try_peek();
+    if (!front) return false;
+    item = *front;
+    _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    return true;
+ }
+
+ // Pointer to the least recently added element, nullptr when empty
+ const T* try_peek() {
+    uint64_t head = _head.load(std::memory_order_relaxed);
+    if (head == _tail_cache) {
+        _tail_cache = _tail.load(std::memory_order_acquire);
+        if (head == _tail_cache) return nullptr;
+    }
+    return &_items[head & _mask];
+ }
+
+ // Access the least recently added element (Peek)
+ // Print an error message on std::cerr and exit in case of underflow
+ const T& peek() {
+    const T* front = try_peek();
+    if (!front) {
+        std::cerr << "Error: Queue underflow. Cannot peek into empty queue." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return *front;
+ }
+
+ // Remove an element from the queue (Dequeue)
+ // Print an error message on std::cerr and exit in case of underflow
+ void dequeue() {
+    peek(); // exits when empty
+    _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+ }
+
+
+ // Observers (any thread; only a snapshot while the other side is running)
+
+ // Check whether the queue is empty
+ bool empty() const { return size() == 0; }
+
+ // Return the number of elements in the queue
+ int size() const {
+    uint64_t head = _head.load(std::memory_order_acquire);
+    uint64_t tail = _tail.load(std::memory_order_acquire);
+    return tail > head ? (int)(tail - head) : 0;
+ }
+
+ // Capacity of the queue
+ int max_size() const { return (int)(_mask + 1); }
+
+private:
+  // Consumer cache line
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> _head; // index of the first element (Head)
+  uint64_t _tail_cache; // consumer's last observed value of _tail
+
+  // Producer cache line
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> _tail; // index of the next available slot (Tail)
+  uint64_t _head_cache; // producer's last observed value of _head
+
+  // Read-only after construction
+  alignas(CACHE_LINE_SIZE) uint64_t _mask; // capacity - 1
+  T* _items; // data container (circular array)
+};
+
+#endif // SPSC_QUEUE_H
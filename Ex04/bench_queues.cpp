@@ -0,0 +1,350 @@
+// bench_queues.cpp
+// Throughput and latency of every queue in the tree, to choose one per pipeline stage
+// and to catch regressions.
+//
+// Build: g++ -std=c++17 -O2 -pthread bench_queues.cpp Ex04-1-2.cpp -o bench_queues
+// Usage: bench_queues [ops]
+//   ops   operations per single-thread row (default: 4194304); threaded rows use ops/16
+//
+// Output is CSV on stdout, one row per (queue, scenario):
+//   queue,scenario,ops,ns_per_op,mops_per_s,p50_ns,p99_ns,p999_ns,allocs_per_op
+// Scenarios:
+//   single    one thread alternates push and pop around a half-full queue; latency
+//             samples cover SAMPLE_OPS consecutive push+pop pairs (one is too short
+//             for the clock) and are reported per pair
+//   burst     a producer thread pushes bursts of BURST_SIZE elements, a consumer
+//             thread pops; latency is the time from push to pop of each element
+//   pingpong  two threads bounce one element through a pair of queues; latency is
+//             one hand-off (half a round trip)
+// Queues without thread safety (Queue, FixedQueue, SoaQueue, ArrayQueue) run the
+// threaded scenarios behind a std::mutex, which is the setup they replace.
+// The Ex02 Queue is the same circular array as the Ex04 one (minus const), so only
+// the latter is measured. allocs_per_op counts calls to operator new during the row.
+#include "Ex04-1-1.cpp" // Queue, Point
+#include "FixedQueue.h"
+#include "SpscQueue.h"
+#include "MpmcQueue.h"
+#include "BlockingQueue.h"
+#include "SoaQueue.h"
+#include "ShmQueue.h"
+#include "../Ex05/ArrayQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+const int CAPACITY = 1024;      // elements per queue
+const int SAMPLE_OPS = 16;      // push+pop pairs per latency sample (single)
+const int BURST_SIZE = 256;     // elements per producer burst (burst)
+
+// Allocation counter: every operator new in the process goes through here
+// (GCC flags the malloc/free pairing once std::allocator calls are inlined; it is correct
+// because every operator new and delete in the program is the pair defined here)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+atomic<uint64_t> g_allocations(0);
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+
+// Log-linear latency histogram in the style of HdrHistogram: values below 2^SUB_BITS
+// are exact, larger ones fall into 2^SUB_BITS buckets per power of two (~6% precision)
+class LatencyHistogram {
+public:
+    LatencyHistogram() : _counts(64 << SUB_BITS, 0), _total(0) {}
+
+    void record(uint64_t ns) {
+        _counts[bucket(ns)]++;
+        _total++;
+    }
+
+    // Upper bound of the bucket holding the q-quantile (0 < q <= 1)
+    uint64_t percentile(double q) const {
+        uint64_t rank = (uint64_t)ceil(q * _total), seen = 0;
+        for (size_t i = 0; i < _counts.size(); ++i) {
+            seen += _counts[i];
+            if (seen >= rank && seen > 0) return upper(i);
+        }
+        return 0;
+    }
+
+private:
+    static const int SUB_BITS = 4;
+    vector<uint64_t> _counts;
+    uint64_t _total;
+
+    static size_t bucket(uint64_t v) {
+        if (v < (1u << SUB_BITS)) return (size_t)v;
+        int k = 63 - __builtin_clzll(v); // k >= SUB_BITS
+        uint64_t sub = (v >> (k - SUB_BITS)) & ((1u << SUB_BITS) - 1);
+        return (size_t)((k - SUB_BITS + 1) << SUB_BITS) + sub;
+    }
+
+    static uint64_t upper(size_t i) {
+        if (i < (1u << SUB_BITS)) return i;
+        int k = (int)(i >> SUB_BITS) + SUB_BITS - 1;
+        uint64_t sub = i & ((1u << SUB_BITS) - 1);
+        return (((uint64_t(1) << SUB_BITS) + sub + 1) << (k - SUB_BITS)) - 1;
+    }
+};
+
+
+// Elements carry a sequence number so the consumer can find their push time
+inline void make_item(int seq, Point& p) { p = Point{seq, 0, 0}; }
+inline void make_item(int seq, string& s) { s = to_string(seq); }
+inline int item_seq(const Point& p) { return p.x; }
+inline int item_seq(const string& s) { return atoi(s.c_str()); }
+
+
+// Uniform try_push / try_pop over the different queue interfaces
+
+inline bool try_push(Queue& q, const Point& p) {
+    if (q.full()) return false;
+    q.enqueue(p);
+    return true;
+}
+inline bool try_pop(Queue& q, Point& p) {
+    if (q.empty()) return false;
+    p = q.peek();
+    q.dequeue();
+    return true;
+}
+
+template <typename T, size_t N>
+bool try_push(FixedQueue<T, N>& q, const T& item) {
+    if (q.full()) return false;
+    q.enqueue(item);
+    return true;
+}
+template <typename T, size_t N>
+bool try_pop(FixedQueue<T, N>& q, T& item) {
+    if (q.empty()) return false;
+    item = q.peek();
+    q.dequeue();
+    return true;
+}
+
+inline bool try_push(SoaQueue& q, const Point& p) {
+    if (q.full()) return false;
+    q.enqueue(p);
+    return true;
+}
+inline bool try_pop(SoaQueue& q, Point& p) {
+    if (q.empty()) return false;
+    p = q.peek();
+    q.dequeue();
+    return true;
+}
+
+// ArrayQueue grows instead of filling up
+inline bool try_push(ArrayQueue<string>& q, const string& s) {
+    q.enqueue(s);
+    return true;
+}
+inline bool try_pop(ArrayQueue<string>& q, string& s) {
+    if (q.empty()) return false;
+    s = q.peek();
+    q.dequeue();
+    return true;
+}
+
+template <typename T> bool try_push(SpscQueue<T>& q, const T& item) { return q.try_enqueue(item); }
+template <typename T> bool try_pop(SpscQueue<T>& q, T& item) { return q.try_dequeue(item); }
+template <typename T> bool try_push(MpmcQueue<T>& q, const T& item) { return q.try_enqueue(item); }
+template <typename T> bool try_pop(MpmcQueue<T>& q, T& item) { return q.try_dequeue(item); }
+template <typename T> bool try_push(BlockingQueue<T>& q, const T& item) { return q.try_push(item); }
+template <typename T> bool try_pop(BlockingQueue<T>& q, T& item) { return q.try_pop(item); }
+inline bool try_push(ShmQueue& q, const Point& p) { return q.try_enqueue(p); }
+inline bool try_pop(ShmQueue& q, Point& p) { return q.try_dequeue(p); }
+
+// A single-threaded queue behind a mutex
+template <typename Q>
+struct Locked {
+    template <typename... Args>
+    explicit Locked(Args... args) : queue(args...) {}
+    Q queue;
+    mutex m;
+};
+template <typename Q, typename T>
+bool try_push(Locked<Q>& q, const T& item) {
+    lock_guard<mutex> lock(q.m);
+    return try_push(q.queue, item);
+}
+template <typename Q, typename T>
+bool try_pop(Locked<Q>& q, T& item) {
+    lock_guard<mutex> lock(q.m);
+    return try_pop(q.queue, item);
+}
+
+// Waiting versions: spin with yield (the threads may share a core), except for
+// BlockingQueue, whose own waiting is what is being measured
+template <typename Q, typename T>
+void push_wait(Q& q, const T& item) {
+    while (!try_push(q, item)) this_thread::yield();
+}
+template <typename Q, typename T>
+void pop_wait(Q& q, T& item) {
+    while (!try_pop(q, item)) this_thread::yield();
+}
+template <typename T> void push_wait(BlockingQueue<T>& q, const T& item) { q.push(item); }
+template <typename T> void pop_wait(BlockingQueue<T>& q, T& item) { item = q.pop(); }
+
+
+struct Result {
+    size_t ops;
+    double seconds;
+    LatencyHistogram latency;
+    uint64_t allocations;
+};
+
+void print_row(const string& queue, const string& scenario, const Result& r) {
+    printf("%s,%s,%zu,%.2f,%.3f,%llu,%llu,%llu,%.4f\n", queue.c_str(), scenario.c_str(), r.ops,
+           r.seconds * 1e9 / r.ops, r.ops / r.seconds / 1e6,
+           (unsigned long long)r.latency.percentile(0.5), (unsigned long long)r.latency.percentile(0.99),
+           (unsigned long long)r.latency.percentile(0.999), (double)r.allocations / r.ops);
+    fflush(stdout);
+}
+
+template <typename Q, typename T>
+Result run_single(Q& q, size_t ops) {
+    Result r{0, 0, LatencyHistogram(), 0};
+    T item, out;
+    for (int i = 0; i < CAPACITY / 2; ++i) {
+        make_item(i, item);
+        try_push(q, item);
+    }
+    make_item(7, item);
+    uint64_t allocs = g_allocations.load();
+    Clock::time_point start = Clock::now(), t0 = start;
+    for (size_t i = 0; i < ops; i += SAMPLE_OPS) {
+        for (int k = 0; k < SAMPLE_OPS; ++k) {
+            try_push(q, item);
+            try_pop(q, out);
+        }
+        Clock::time_point t1 = Clock::now();
+        r.latency.record((uint64_t)chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count() / SAMPLE_OPS);
+        t0 = t1;
+        r.ops += SAMPLE_OPS;
+    }
+    r.seconds = chrono::duration<double>(Clock::now() - start).count();
+    r.allocations = g_allocations.load() - allocs;
+    while (try_pop(q, out)) {}
+    return r;
+}
+
+template <typename Q, typename T>
+Result run_burst(Q& q, size_t ops) {
+    Result r{ops, 0, LatencyHistogram(), 0};
+    vector<Clock::time_point> pushed(ops);
+    vector<T> items(ops);
+    for (size_t i = 0; i < ops; ++i) make_item((int)i, items[i]);
+
+    uint64_t allocs = g_allocations.load();
+    Clock::time_point start = Clock::now();
+    thread consumer([&]() {
+        T item;
+        for (size_t i = 0; i < ops; ++i) {
+            pop_wait(q, item);
+            r.latency.record((uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+                Clock::now() - pushed[item_seq(item)]).count());
+        }
+    });
+    for (size_t i = 0; i < ops; ) {
+        for (size_t end = min(ops, i + BURST_SIZE); i < end; ++i) {
+            pushed[i] = Clock::now(); // published by the push
+            push_wait(q, items[i]);
+        }
+        this_thread::yield(); // gap between bursts
+    }
+    consumer.join();
+    r.seconds = chrono::duration<double>(Clock::now() - start).count();
+    r.allocations = g_allocations.load() - allocs;
+    return r;
+}
+
+template <typename Q, typename T>
+Result run_pingpong(Q& ping, Q& pong, size_t ops) {
+    Result r{ops, 0, LatencyHistogram(), 0};
+    uint64_t allocs = g_allocations.load();
+    Clock::time_point start = Clock::now();
+    thread echo([&]() {
+        T item;
+        for (size_t i = 0; i < ops; i += 2) {
+            pop_wait(ping, item);
+            push_wait(pong, item);
+        }
+    });
+    T item;
+    make_item(1, item);
+    for (size_t i = 0; i < ops; i += 2) {
+        Clock::time_point t0 = Clock::now();
+        push_wait(ping, item);
+        pop_wait(pong, item);
+        r.latency.record((uint64_t)chrono::duration_cast<chrono::nanoseconds>(Clock::now() - t0).count() / 2);
+    }
+    echo.join();
+    r.seconds = chrono::duration<double>(Clock::now() - start).count();
+    r.allocations = g_allocations.load() - allocs;
+    return r;
+}
+
+// Runs the three scenarios; make() returns a fresh, empty queue
+template <typename Q, typename T>
+void bench(const string& name, function<Q*()> make, size_t ops) {
+    unique_ptr<Q> q(make());
+    print_row(name, "single", run_single<Q, T>(*q, ops));
+    q.reset(make());
+    print_row(name, "burst", run_burst<Q, T>(*q, ops / 16));
+    unique_ptr<Q> q2(make());
+    print_row(name, "pingpong", run_pingpong<Q, T>(*q, *q2, ops / 16));
+}
+
+// Single-threaded queues: plain in "single", behind a mutex in the threaded scenarios
+// args are passed to the queue's constructor
+template <typename Q, typename T, typename... Args>
+void bench_locked(const string& name, size_t ops, Args... args) {
+    unique_ptr<Q> q(new Q(args...));
+    print_row(name, "single", run_single<Q, T>(*q, ops));
+    unique_ptr<Locked<Q>> l(new Locked<Q>(args...));
+    print_row(name + "+mutex", "burst", run_burst<Locked<Q>, T>(*l, ops / 16));
+    unique_ptr<Locked<Q>> l2(new Locked<Q>(args...));
+    print_row(name + "+mutex", "pingpong", run_pingpong<Locked<Q>, T>(*l, *l2, ops / 16));
+}
+
+int main(int argc, char* argv[]) {
+    size_t ops = argc > 1 ? stoull(argv[1]) : (size_t(1) << 22);
+
+    printf("queue,scenario,ops,ns_per_op,mops_per_s,p50_ns,p99_ns,p999_ns,allocs_per_op\n");
+    bench_locked<Queue, Point>("Queue", ops, CAPACITY);
+    bench_locked<FixedQueue<Point, CAPACITY>, Point>("FixedQueue", ops);
+    bench_locked<SoaQueue, Point>("SoaQueue", ops, CAPACITY);
+    bench_locked<ArrayQueue<string>, string>("ArrayQueue<string>", ops, CAPACITY);
+    bench<SpscQueue<Point>, Point>("SpscQueue", [] { return new SpscQueue<Point>(CAPACITY); }, ops);
+    bench<MpmcQueue<Point>, Point>("MpmcQueue", [] { return new MpmcQueue<Point>(CAPACITY); }, ops);
+    bench<BlockingQueue<Point>, Point>("BlockingQueue", [] { return new BlockingQueue<Point>(CAPACITY); }, ops);
+    int shm_id = 0;
+    bench<ShmQueue, Point>("ShmQueue", [&shm_id] {
+        string name = "/bench_queues_" + to_string(getpid()) + "_" + to_string(shm_id++);
+        ShmQueue* q = new ShmQueue(name, CAPACITY);
+        ShmQueue::unlink(name); // the mapping stays until the queue is destroyed
+        return q;
+    }, ops);
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "Ex04-1-1.cpp" // Point
+#include "BlockingQueue.h"
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <ctime>
+
+using namespace std::chrono;
+
+void print_test_result(const char* test_name, bool result) {
+    std::cout << "[" << (result ? "OK" : "FAIL") << "] " << test_name << std::endl;
+}
+
+// Single-threaded checks, including the timeouts
+void test_single_thread() {
+    std::cout << "--- BlockingQueue<Point> Single-thread Test ---" << std::endl;
+
+    BlockingQueue<Point> q(2);
+    Point p;
+    print_test_result("T1: try_pop fails when empty", !q.try_pop(p) && q.empty());
+
+    auto t0 = steady_clock::now();
+    bool popped = q.pop_for(p, milliseconds(20));
+    auto waited = steady_clock::now() - t0;
+    print_test_result("T2: pop_for times out on an empty queue", !popped && waited >= milliseconds(20));
+
+    q.push(Point{1, 2, 3});
+    q.push(Point{4, 5, 6});
+    t0 = steady_clock::now();
+    bool pushed = q.push_for(Point{7, 8, 9}, milliseconds(20));
+    waited = steady_clock::now() - t0;
+    print_test_result("T3: push_for times out on a full queue", !pushed && waited >= milliseconds(20) && q.size() == 2);
+
+    print_test_result("T4: pop returns elements in FIFO order", q.pop().x == 1 && q.pop().x == 4 && q.empty());
+}
+
+// Producers and consumers that block on full / empty: every Point arrives exactly once
+void test_threads() {
+    std::cout << "\n--- BlockingQueue<Point> Producer/Consumer Test ---" << std::endl;
+
+    const int PRODUCERS = 3, CONSUMERS = 2, PER_PRODUCER = 200000;
+    BlockingQueue<Point> q(64);
+    std::vector<long long> sums(CONSUMERS, 0);
+    std::vector<std::thread> threads;
+    for (int c = 0; c < CONSUMERS; ++c) {
+        threads.emplace_back([&, c]() {
+            for (int i = 0; i < PRODUCERS * PER_PRODUCER / CONSUMERS; ++i) sums[c] += q.pop().y;
+        });
+    }
+    for (int t = 0; t < PRODUCERS; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < PER_PRODUCER; ++i) q.push(Point{t, i, 0});
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    long long sum = 0;
+    for (long long s : sums) sum += s;
+    print_test_result("T5: 3 producers / 2 consumers, every Point once",
+                      q.empty() && sum == (long long)PRODUCERS * PER_PRODUCER * (PER_PRODUCER - 1) / 2);
+}
+
+// A consumer blocked in pop() should not use the CPU, and should wake up quickly
+void test_idle_and_latency() {
+    std::cout << "\n--- BlockingQueue<Point> Idle CPU and Wake-up Latency ---" << std::endl;
+
+    BlockingQueue<Point> q(16);
+    std::clock_t cpu0 = std::clock();
+    std::thread consumer([&]() { q.pop(); });
+    std::this_thread::sleep_for(milliseconds(200));
+    double cpu_ms = 1000.0 * (std::clock() - cpu0) / CLOCKS_PER_SEC;
+    q.push(Point{0, 0, 0});
+    consumer.join();
+    std::cout << "   CPU time while a consumer waited 200 ms: " << cpu_ms << " ms" << std::endl;
+    print_test_result("T6: Blocked consumer is idle", cpu_ms < 20);
+
+    // Ping-pong: each round trip is two hand-offs through sleeping threads
+    const int ROUNDS = 2000;
+    BlockingQueue<Point> ping(16), pong(16);
+    std::thread echo([&]() {
+        for (int i = 0; i < ROUNDS; ++i) pong.push(ping.pop());
+    });
+    bool echoed = true;
+    auto t0 = steady_clock::now();
+    for (int i = 0; i < ROUNDS; ++i) {
+        ping.push(Point{i, 0, 0});
+        echoed = echoed && pong.pop().x == i;
+    }
+    double us = duration<double, std::micro>(steady_clock::now() - t0).count() / ROUNDS / 2;
+    echo.join();
+    print_test_result("T7: Ping-pong delivers every Point", echoed);
+    std::cout << "   Average hand-off latency: " << us << " us" << std::endl;
+}
+
+int main(void) {
+    test_single_thread();
+    test_threads();
+    test_idle_and_latency();
+
+    std::cout << "\nAll BlockingQueue tests completed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "Ex04-1-1.cpp" // Point
+#include "FixedQueue.h"
+#include <iostream>
+#include <cstdint>
+
+// Helper function to print a Point object. Argument is const reference for efficiency.
+void print_point(const Point& p) {
+    std::cout << "(" << p.x << ", " << p.y << ", " << p.z << ")";
+}
+
+bool same_point(const Point& a, const Point& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+void print_test_result(const char* test_name, bool result) {
+    std::cout << "[" << (result ? "OK" : "FAIL") << "] " << test_name << std::endl;
+}
+
+// Main function to test the FixedQueue implementation.
+int main(void) {
+    std::cout << "--- FixedQueue<Point, 4> Test ---" << std::endl;
+
+    FixedQueue<Point, 4> q;
+    const FixedQueue<Point, 4>& const_q = q;
+    print_test_result("T1: Initially empty", const_q.empty() && const_q.size() == 0 && !const_q.full());
+
+    // 1. FIFO order
+    Point p1 = {10, 100, 1000};
+    Point p2 = {20, 200, 2000};
+    Point p3 = {30, 300, 3000};
+    q.enqueue(p1);
+    q.enqueue(p2);
+    q.enqueue(p3);
+    std::cout << "Front element (Expected P1): "; print_point(const_q.peek()); std::cout << std::endl;
+    print_test_result("T2: Size after 3 enqueues", const_q.size() == 3);
+    q.dequeue();
+    print_test_result("T3: FIFO order", same_point(const_q.peek(), p2));
+
+    // 2. Wrap-around of the masked indices, up to full capacity
+    Point p4 = {40, 400, 4000};
+    Point p5 = {50, 500, 5000};
+    q.enqueue(p4);
+    q.enqueue(p5);
+    print_test_result("T4: Full at capacity 4", const_q.full() && const_q.size() == 4);
+    Point expected[] = {p2, p3, p4, p5};
+    bool ok = true;
+    for (int i = 0; i < 4; ++i) {
+        ok = ok && same_point(const_q.peek(), expected[i]);
+        q.dequeue();
+    }
+    print_test_result("T5: Dequeue order across the wrap-around", ok && const_q.empty());
+
+    // 3. Many cycles: indices keep growing while the slot index stays masked
+    FixedQueue<int, 8> cycle;
+    ok = true;
+    for (int i = 0; i < 1000000; ++i) {
+        cycle.enqueue(i);
+        if (cycle.size() == 5) {
+            ok = ok && cycle.peek() == i - 4;
+            cycle.dequeue();
+        }
+    }
+    print_test_result("T6: 10^6 enqueue/dequeue cycles", ok && cycle.size() == 4);
+
+    // 4. The storage is inline: no pointer, no allocation
+    print_test_result("T7: sizeof(FixedQueue<Point, 1024>) holds the items inline",
+                      sizeof(FixedQueue<Point, 1024>) >= 1024 * sizeof(Point));
+
+    std::cout << "\nAll FixedQueue tests completed." << std::endl;
+    return 0;
+}
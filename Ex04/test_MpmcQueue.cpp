@@ -0,0 +1,102 @@
+#include "Ex04-1-1.cpp" // Point
+#include "MpmcQueue.h"
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+void print_test_result(const char* test_name, bool result) {
+    std::cout << "[" << (result ? "OK" : "FAIL") << "] " << test_name << std::endl;
+}
+
+// Single-threaded checks of the queue semantics
+void test_single_thread() {
+    std::cout << "--- MpmcQueue<Point> Single-thread Test ---" << std::endl;
+
+    MpmcQueue<Point> q(5); // rounded up to 8
+    print_test_result("T1: Capacity rounded up to a power of two", q.max_size() == 8 && q.empty());
+
+    int accepted = 0;
+    for (int i = 0; i < 20; ++i) accepted += q.try_enqueue(Point{i, 2 * i, 3 * i});
+    print_test_result("T2: try_enqueue stops at capacity", accepted == 8 && q.size() == 8);
+
+    Point p;
+    bool fifo = true;
+    for (int i = 0; i < 8; ++i) fifo = fifo && q.try_dequeue(p) && p.x == i && p.z == 3 * i;
+    print_test_result("T3: Elements come out in FIFO order", fifo);
+    print_test_result("T4: try_dequeue fails when empty", !q.try_dequeue(p) && q.empty());
+
+    // Several rounds over the same slots
+    bool rounds = true;
+    for (int i = 0; i < 100; ++i) {
+        q.enqueue(Point{i, i, i});
+        rounds = rounds && q.dequeue().y == i;
+    }
+    print_test_result("T5: Slots are reused across rounds", rounds && q.empty());
+}
+
+// Several producers and consumers: every Point arrives exactly once and
+// each producer's Points arrive in the order they were sent
+void test_threads(const char* label, int producers, int consumers) {
+    const int PER_PRODUCER = 1000000;
+    MpmcQueue<Point> q(1024);
+    std::vector<std::vector<int>> seen(consumers, std::vector<int>(producers, 0));
+    std::vector<char> ordered(consumers, 1);
+    std::vector<long long> sums(consumers, 0);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c]() {
+            // Consumers split the total evenly; the first takes the remainder
+            int count = producers * PER_PRODUCER / consumers;
+            if (c == 0) count += producers * PER_PRODUCER % consumers;
+            std::vector<int> last(producers, -1);
+            for (int i = 0; i < count; ++i) {
+                Point p = q.dequeue();
+                if (p.y <= last[p.x]) ordered[c] = 0;
+                last[p.x] = p.y;
+                seen[c][p.x]++;
+                sums[c] += p.y;
+            }
+        });
+    }
+    for (int t = 0; t < producers; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < PER_PRODUCER; ++i) q.enqueue(Point{t, i, 0});
+        });
+    }
+    for (auto& t : threads) t.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bool complete = q.empty();
+    long long sum = 0;
+    for (int c = 0; c < consumers; ++c) {
+        complete = complete && ordered[c];
+        sum += sums[c];
+    }
+    for (int t = 0; t < producers; ++t) {
+        int total = 0;
+        for (int c = 0; c < consumers; ++c) total += seen[c][t];
+        complete = complete && total == PER_PRODUCER;
+    }
+    complete = complete && sum == (long long)producers * PER_PRODUCER * (PER_PRODUCER - 1) / 2;
+
+    std::string name = std::string(label) + ": " + std::to_string(producers) + " producers / " +
+                       std::to_string(consumers) + " consumers, every Point once";
+    print_test_result(name.c_str(), complete);
+    std::cout << "   Throughput: " << producers * PER_PRODUCER / seconds / 1e6 << " M Points/s" << std::endl;
+}
+
+int main(void) {
+    test_single_thread();
+
+    std::cout << "\n--- MpmcQueue<Point> Multi-thread Test ---" << std::endl;
+    test_threads("T6", 1, 1);
+    test_threads("T7", 2, 2);
+    test_threads("T8", 4, 3);
+    test_threads("T9", 8, 8);
+
+    std::cout << "\nAll MpmcQueue tests completed." << std::endl;
+    return 0;
+}
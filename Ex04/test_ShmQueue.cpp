@@ -0,0 +1,118 @@
+#include "ShmQueue.h"
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <sys/wait.h>
+
+void print_test_result(const char* test_name, bool result) {
+    std::cout << "[" << (result ? "OK" : "FAIL") << "] " << test_name << std::endl;
+}
+
+const char* NAME = "/ex04_test_shm_queue";
+
+void test_single_process() {
+    std::cout << "--- ShmQueue Single-process Test ---" << std::endl;
+    ShmQueue::unlink(NAME);
+
+    ShmQueue q(NAME, 3); // rounded up to 4
+    print_test_result("T1: New queue is empty, capacity rounded up", q.empty() && q.max_size() == 4);
+
+    int accepted = 0;
+    for (int i = 0; i < 10; ++i) accepted += q.try_enqueue(Point{i, i, i});
+    print_test_result("T2: try_enqueue stops at capacity", accepted == 4 && q.size() == 4);
+
+    // A second mapping of the same segment sees the same ring at another address
+    ShmQueue other(NAME);
+    print_test_result("T3: Attach sees the contents", other.size() == 4 && other.peek().x == 0 &&
+                      &other.peek() != &q.peek());
+    other.dequeue();
+    print_test_result("T4: Dequeue through one mapping is visible in the other", q.size() == 3 && q.peek().x == 1);
+
+    other.detach();
+    q.reinitialize();
+    print_test_result("T5: reinitialize() empties the ring", q.empty() && q.generation() == 2);
+
+    bool threw = false;
+    try { ShmQueue wrong(NAME, 64); } catch (const std::runtime_error&) { threw = true; }
+    print_test_result("T6: Capacity mismatch is rejected", threw);
+
+    q.detach();
+    ShmQueue::unlink(NAME);
+    threw = false;
+    try { ShmQueue missing(NAME); } catch (const std::runtime_error&) { threw = true; }
+    print_test_result("T7: Attaching to a missing queue throws", threw);
+}
+
+// A crash in the middle of initialization leaves a segment without the magic
+void test_half_initialized() {
+    std::cout << "\n--- ShmQueue Crash Recovery Test ---" << std::endl;
+    ShmQueue::unlink(NAME);
+    int fd = shm_open(NAME, O_RDWR | O_CREAT, 0600);
+    bool sized = ftruncate(fd, 4096) == 0;
+    close(fd);
+
+    ShmQueue q(NAME, 16);
+    print_test_result("T8: Half-initialized segment is rebuilt", sized && q.empty() && q.max_size() == 16);
+
+    // Producer process dies with Points still in the ring
+    pid_t pid = fork();
+    if (pid == 0) {
+        ShmQueue producer(NAME);
+        producer.enqueue(Point{1, 2, 3});
+        producer.enqueue(Point{4, 5, 6});
+        _exit(0); // no destructor, no detach
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    print_test_result("T9: Points left by a dead producer are readable", q.size() == 2 && q.peek().z == 3);
+    q.reinitialize();
+    print_test_result("T10: Survivor can reset the ring", q.empty());
+
+    q.detach();
+    ShmQueue::unlink(NAME);
+}
+
+// Producer in this process, consumer in a child process
+void test_two_processes() {
+    std::cout << "\n--- ShmQueue Producer/Consumer Processes ---" << std::endl;
+    const int COUNT = 5000000;
+    ShmQueue::unlink(NAME);
+    ShmQueue q(NAME, 4096);
+
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid == 0) {
+        ShmQueue consumer(NAME);
+        Point p;
+        bool ok = true;
+        for (int expected = 0; expected < COUNT; ) {
+            if (!consumer.try_dequeue(p)) { std::this_thread::yield(); continue; }
+            ok = ok && p.x == expected && p.y == -expected && p.z == expected / 2;
+            ++expected;
+        }
+        _exit(ok ? 0 : 1);
+    }
+    for (int i = 0; i < COUNT; ) {
+        if (q.try_enqueue(Point{i, -i, i / 2})) ++i;
+        else std::this_thread::yield();
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    print_test_result("T11: Child process received every Point in order",
+                      WIFEXITED(status) && WEXITSTATUS(status) == 0 && q.empty());
+    std::cout << "   Throughput: " << COUNT / seconds / 1e6 << " M Points/s" << std::endl;
+
+    q.detach();
+    ShmQueue::unlink(NAME);
+}
+
+int main(void) {
+    test_single_process();
+    test_half_initialized();
+    test_two_processes();
+
+    std::cout << "\nAll ShmQueue tests completed." << std::endl;
+    return 0;
+}
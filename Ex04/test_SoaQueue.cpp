@@ -0,0 +1,140 @@
+#include "SoaQueue.h"
+#include <iostream>
+#include <random>
+#include <vector>
+#include <chrono>
+
+void print_test_result(const char* test_name, bool result) {
+    std::cout << "[" << (result ? "OK" : "FAIL") << "] " << test_name << std::endl;
+}
+
+bool same_point(const Point& a, const Point& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+// Element-by-element versions of the reductions, for comparison
+struct Reference {
+    BoundingBox box;
+    PointSum sum;
+    std::vector<Point> in_range;
+};
+
+Reference reference(const std::vector<Point>& window, int axis, int lo, int hi) {
+    Reference ref;
+    ref.box = BoundingBox{window[0], window[0]};
+    ref.sum = PointSum{0, 0, 0};
+    for (const Point& p : window) {
+        ref.box.min = Point{std::min(ref.box.min.x, p.x), std::min(ref.box.min.y, p.y), std::min(ref.box.min.z, p.z)};
+        ref.box.max = Point{std::max(ref.box.max.x, p.x), std::max(ref.box.max.y, p.y), std::max(ref.box.max.z, p.z)};
+        ref.sum.x += p.x;
+        ref.sum.y += p.y;
+        ref.sum.z += p.z;
+        int key = axis == 0 ? p.x : axis == 1 ? p.y : p.z;
+        if (key >= lo && key <= hi) ref.in_range.push_back(p);
+    }
+    return ref;
+}
+
+void test_basic() {
+    std::cout << "--- SoaQueue Basic Test ---" << std::endl;
+
+    SoaQueue q(5); // rounded up to 8
+    print_test_result("T1: Capacity rounded up to a power of two", q.max_size() == 8 && q.empty());
+
+    Point p1 = {10, 100, 1000};
+    Point p2 = {-20, 200, 2000};
+    q.enqueue(p1);
+    q.enqueue(p2);
+    print_test_result("T2: Peek returns the first element", same_point(q.peek(), p1));
+    q.dequeue();
+    print_test_result("T3: Dequeue removes it", q.size() == 1 && same_point(q.peek(), p2));
+
+    PointSum s = q.sum();
+    Centroid c = q.centroid();
+    print_test_result("T4: Sum and centroid of one element", s.x == -20 && s.z == 2000 && c.y == 200.0);
+    q.dequeue();
+    s = q.sum();
+    print_test_result("T5: Sum of an empty queue is zero", s.x == 0 && s.y == 0 && s.z == 0);
+
+    bool rejected = false;
+    try {
+        SoaQueue huge(SoaQueue::MAX_CAPACITY + 1);
+    } catch (const std::length_error&) {
+        rejected = true;
+    }
+    print_test_result("T6: Capacity above 2^30 is rejected", rejected);
+}
+
+// Random windows at every head position, so that runs of every length and
+// alignment (and the wrap-around split) go through both the vector and scalar paths
+void test_reductions() {
+    std::cout << "\n--- SoaQueue Reductions vs Element-by-element ---" << std::endl;
+
+    const int CAPACITY = 64;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> coord(INT_MIN, INT_MAX);
+    bool box_ok = true, sum_ok = true, filter_ok = true;
+
+    SoaQueue q(CAPACITY);
+    std::vector<Point> window;
+    for (int step = 0; step < 2000; ++step) {
+        // Random walk of the window size between 1 and CAPACITY
+        if (q.full() || (q.size() > 1 && rng() % 2)) {
+            q.dequeue();
+            window.erase(window.begin());
+        } else {
+            Point p = {coord(rng), coord(rng), (int)(rng() % 100)};
+            q.enqueue(p);
+            window.push_back(p);
+        }
+
+        int axis = step % 3;
+        int lo = axis == 2 ? 20 : -(1 << 30), hi = axis == 2 ? 60 : (1 << 30);
+        Reference ref = reference(window, axis, lo, hi);
+
+        BoundingBox box = q.bounding_box();
+        box_ok = box_ok && same_point(box.min, ref.box.min) && same_point(box.max, ref.box.max);
+        PointSum s = q.sum();
+        sum_ok = sum_ok && s.x == ref.sum.x && s.y == ref.sum.y && s.z == ref.sum.z;
+
+        std::vector<Point> out(q.size());
+        int n = q.filter(axis, lo, hi, out.data());
+        bool same = n == (int)ref.in_range.size() && q.count_in_range(axis, lo, hi) == n;
+        for (int i = 0; same && i < n; ++i) same = same_point(out[i], ref.in_range[i]);
+        filter_ok = filter_ok && same;
+    }
+    print_test_result("T7: Bounding box matches", box_ok);
+    print_test_result("T8: Sum matches (no overflow on extreme coordinates)", sum_ok);
+    print_test_result("T9: Filter and count match, in FIFO order", filter_ok);
+}
+
+void bench_reductions() {
+    std::cout << "\n--- SoaQueue Reduction Throughput ---" << std::endl;
+
+    const int CAPACITY = 1 << 16;
+    const int REPEAT = 200;
+    SoaQueue q(CAPACITY);
+    for (int i = 0; i < CAPACITY / 2; ++i) q.enqueue(Point{i, -i, i % 1000});
+    for (int i = 0; i < CAPACITY / 4; ++i) q.dequeue();
+    for (int i = 0; i < CAPACITY / 2; ++i) q.enqueue(Point{i, i, i}); // wraps around
+
+    long long checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < REPEAT; ++r) {
+        BoundingBox box = q.bounding_box();
+        Centroid c = q.centroid();
+        checksum += box.max.x + (long long)c.z + q.count_in_range(2, 100, 200 + r);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "   " << q.size() << " Points, box + centroid + count: "
+              << (double)REPEAT * q.size() / seconds / 1e6 << " M Points/s (checksum " << checksum << ")" << std::endl;
+}
+
+int main(void) {
+    test_basic();
+    test_reductions();
+    bench_reductions();
+
+    std::cout << "\nAll SoaQueue tests completed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "Ex04-1-1.cpp" // Point
+#include "SpscQueue.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+
+void print_test_result(const char* test_name, bool result) {
+    std::cout << "[" << (result ? "OK" : "FAIL") << "] " << test_name << std::endl;
+}
+
+// Single-threaded checks of the queue semantics
+void test_single_thread() {
+    std::cout << "--- SpscQueue<Point> Single-thread Test ---" << std::endl;
+
+    SpscQueue<Point> q(3); // rounded up to 4
+    print_test_result("T1: Capacity rounded up to a power of two", q.max_size() == 4 && q.empty());
+
+    Point p1 = {10, 100, 1000};
+    Point p2 = {20, 200, 2000};
+    q.enqueue(p1);
+    q.enqueue(p2);
+    print_test_result("T2: Peek returns the first element", q.size() == 2 && q.peek().x == 10);
+    q.dequeue();
+    print_test_result("T3: Dequeue removes it", q.size() == 1 && q.peek().x == 20);
+
+    // try_enqueue reports overflow instead of exiting
+    int accepted = 0;
+    for (int i = 0; i < 10; ++i) accepted += q.try_enqueue(Point{i, i, i});
+    print_test_result("T4: try_enqueue stops at capacity", accepted == 3 && q.size() == 4);
+
+    Point out;
+    int removed = 0;
+    while (q.try_dequeue(out)) ++removed;
+    print_test_result("T5: try_dequeue drains the queue", removed == 4 && q.empty() && out.x == 2);
+}
+
+// One producer and one consumer thread: every Point arrives exactly once, in order
+void test_two_threads() {
+    std::cout << "\n--- SpscQueue<Point> Producer/Consumer Test ---" << std::endl;
+
+    const int COUNT = 10000000;
+    SpscQueue<Point> q(1024);
+    bool in_order = true;
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread consumer([&]() {
+        Point p;
+        for (int expected = 0; expected < COUNT; ) {
+            if (!q.try_dequeue(p)) { std::this_thread::yield(); continue; }
+            if (p.x != expected || p.y != -expected || p.z != 2 * expected) in_order = false;
+            ++expected;
+        }
+    });
+    for (int i = 0; i < COUNT; ) {
+        if (q.try_enqueue(Point{i, -i, 2 * i})) ++i;
+        else std::this_thread::yield(); // matters when both threads share a core
+    }
+    consumer.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    print_test_result("T6: 10^7 Points transferred in order", in_order && q.empty());
+    std::cout << "   Throughput: " << COUNT / seconds / 1e6 << " M Points/s" << std::endl;
+}
+
+int main(void) {
+    test_single_thread();
+    test_two_threads();
+
+    std::cout << "\nAll SpscQueue tests completed." << std::endl;
+    return 0;
+}
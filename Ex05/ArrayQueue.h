@@ -2,110 +2,446 @@
 
 #include <string>
 #include <iostream>
+#include <algorithm>   // For std::min, std::max
+#include <chrono>      // For TimedShrink
+#include <memory>      // For std::allocator, std::allocator_traits
+#include <memory_resource> // For std::pmr::polymorphic_allocator
+#include <new>
+#include <cstring>     // For std::memcpy
+#include <type_traits>
+#include <utility>     // For std::move, std::forward, std::swap
+#include <stdexcept>
 
 #ifndef ARRAY_QUEUE_H
 #define ARRAY_QUEUE_H
 
+// Growth policies: when and how far ArrayQueue resizes its array.
+// A policy provides
+//   int grow(int capacity)                  new capacity for a full queue (> capacity)
+//   int shrink(int num_items, int capacity) capacity after a dequeue (the same to keep it)
+// and may keep state between calls: each queue has its own policy object.
+
+// Doubles when full, halves when a dequeue leaves exactly a quarter (above 4 slots),
+// so a queue created with a large capacity keeps it while it stays below a quarter
+struct DoublingGrowth {
+    int grow(int capacity) const { return capacity > 0 ? 2 * capacity : 1; }
+    int shrink(int num_items, int capacity) const {
+        return num_items > 0 && capacity > 4 && num_items == capacity / 4 ? capacity / 2 : capacity;
+    }
+};
+
+// Grows by Num/Den (e.g. <3, 2> for 1.5x), halves at a quarter or less, never shrinks
+// below MinCapacity
+template <int Num, int Den, int MinCapacity = 1>
+struct GeometricGrowth {
+    static_assert(Num > Den && Den > 0, "GeometricGrowth factor must be greater than 1");
+    static_assert(MinCapacity > 0, "GeometricGrowth minimum capacity must be positive");
+
+    int grow(int capacity) const {
+        return std::max({(int)((long long)capacity * Num / Den), capacity + 1, MinCapacity});
+    }
+    int shrink(int num_items, int capacity) const {
+        if (num_items == 0 || num_items > capacity / 4) return capacity;
+        return std::min(capacity, std::max(capacity / 2, MinCapacity));
+    }
+};
+
+// Item count the shrink wrappers below pass to Base: a non-empty queue holding less
+// than a quarter of the capacity is reported at the quarter mark, so that Base keeps
+// asking to shrink while the queue stays small (DoublingGrowth on its own asks only
+// when a dequeue leaves exactly a quarter)
+inline int quarter_or_less(int num_items, int capacity) {
+    return num_items > 0 && num_items < capacity / 4 ? capacity / 4 : num_items;
+}
+
+// Shrinks only after Base has asked to shrink on Delay dequeues in a row, so a queue
+// oscillating around Base's threshold keeps its array
+template <typename Base, int Delay>
+struct DelayedShrink : Base {
+    int _pending = 0; // consecutive dequeues on which Base asked to shrink
+
+    int shrink(int num_items, int capacity) {
+        int target = Base::shrink(quarter_or_less(num_items, capacity), capacity);
+        if (target == capacity) {
+            _pending = 0;
+            return capacity;
+        }
+        if (++_pending < Delay) return capacity;
+        _pending = 0;
+        return target;
+    }
+};
+
+// Shrinks only once Base has kept asking to shrink for at least Millis milliseconds
+// (Base is asked through quarter_or_less as well)
+template <typename Base, int Millis>
+struct TimedShrink : Base {
+    using Clock = std::chrono::steady_clock;
+    bool _pending = false;     // Base asked to shrink on every dequeue since _since
+    Clock::time_point _since;
+
+    int shrink(int num_items, int capacity) {
+        int target = Base::shrink(quarter_or_less(num_items, capacity), capacity);
+        if (target == capacity) {
+            _pending = false;
+            return capacity;
+        }
+        Clock::time_point now = Clock::now();
+        if (!_pending) {
+            _pending = true;
+            _since = now;
+            return capacity;
+        }
+        if (now - _since < std::chrono::milliseconds(Millis)) return capacity;
+        _pending = false;
+        return target;
+    }
+};
+
+// Resize telemetry of an ArrayQueue
+struct ArrayQueueStats {
+    long long resizes = 0;      // number of reallocations (growing or shrinking)
+    long long bytes_moved = 0;  // element bytes relocated by them
+    int peak_capacity = 0;      // largest capacity so far
+};
+
+// Unbounded FIFO queue over a circular array that doubles when full and halves
+// when only a quarter is used.
+//
+// Slots are raw storage: an element is constructed when it is enqueued and
+// destroyed when it is dequeued, so empty slots cost no constructor calls and T
+// needs no default constructor. Resizing relocates the elements with memcpy when T
+// is trivially copyable and with move construction otherwise (copy only if the
+// move constructor may throw), so growing a queue of strings moves pointers
+// instead of copying characters.
+//
+// Memory comes from an Allocator (std::allocator by default) and elements are built
+// with allocator_traits::construct, so with a scoped allocator such as
+// std::pmr::polymorphic_allocator the elements (e.g. pmr::string) use the queue's
+// memory resource too. Copy, move and swap follow the allocator's propagation traits
+// like the standard containers. PmrArrayQueue<T> is the std::pmr instantiation.
+//
+// When to grow and shrink is decided by GrowthPolicy (see DoublingGrowth above), and
+// stats() reports how many resizes happened and how many bytes they moved, to tune
+// the policy to a queue's traffic.
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
 class ArrayQueue {
+public:
+    using allocator_type = Allocator;
+
 private:
+    using Traits = std::allocator_traits<Allocator>;
+
     int _num_items;        // number of items in the queue
     int _allocated_size;   // size of memory allocated
-    int _first;            // index to the first element of the queue 
-    int _last;             // index of the next available slot 
-    std::string* _items;   // container 
-    
+    int _first;            // index to the first element of the queue
+    int _last;             // index of the next available slot
+    T* _items;             // container (uninitialized storage outside the queued range)
+    Allocator _alloc;      // source of _items and of the elements' construction
+    GrowthPolicy _policy;  // when to resize
+    ArrayQueueStats _stats; // resize telemetry (not exchanged by swap or assignment)
+
+    T* allocate(int n) { return n > 0 ? Traits::allocate(_alloc, n) : nullptr; }
+    void deallocate(T* p, int n) { if (p) Traits::deallocate(_alloc, p, n); }
+
+    // Index in _items of the i-th element in FIFO order
+    int slot(int i) const {
+        int k = _first + i;
+        return k < _allocated_size ? k : k - _allocated_size;
+    }
+
+    // Moves the elements to the front of dest in FIFO order and destroys the originals.
+    // When T is copied (its move may throw) the originals are destroyed only once every
+    // copy is made: if one throws, the copies are destroyed and the queue is unchanged.
+    void relocate_to(T* dest) {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            // At most two contiguous runs: [_first, end) and [0, rest)
+            int head = std::min(_num_items, _allocated_size - _first);
+            if (head > 0) std::memcpy(static_cast<void*>(dest), _items + _first, head * sizeof(T));
+            if (_num_items > head) std::memcpy(static_cast<void*>(dest + head), _items, (_num_items - head) * sizeof(T));
+        } else if constexpr (std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value) {
+            for (int i = 0; i < _num_items; ++i) {
+                T& item = _items[slot(i)];
+                Traits::construct(_alloc, dest + i, std::move_if_noexcept(item));
+                Traits::destroy(_alloc, &item);
+            }
+        } else {
+            int i = 0;
+            try {
+                for (; i < _num_items; ++i) Traits::construct(_alloc, dest + i, std::as_const(_items[slot(i)]));
+            } catch (...) {
+                while (i > 0) Traits::destroy(_alloc, dest + --i);
+                throw;
+            }
+            for (i = 0; i < _num_items; ++i) Traits::destroy(_alloc, &_items[slot(i)]);
+        }
+    }
+
+    void count_resize(int new_size) {
+        _stats.resizes++;
+        _stats.bytes_moved += (long long)_num_items * sizeof(T);
+        _stats.peak_capacity = std::max(_stats.peak_capacity, new_size);
+    }
+
     // Helper function to dynamically change the size of the underlying array
     void resize(int max_size) {
         // Ensure a minimum size of 1 if max_size is calculated as 0
-        if (max_size == 0) max_size = 1; 
-
-        // Move data to a new array of size max_size
-        std::string* temp = new std::string[max_size];
-        
-        // Copy elements in logical FIFO order
-        for (int i = 0; i < _num_items; ++i) {
-            // Calculate the index in the old array using modulo arithmetic
-            temp[i] = _items[(i + _first) % _allocated_size];
+        if (max_size == 0) max_size = 1;
+
+        T* temp = allocate(max_size);
+        try {
+            relocate_to(temp);
+        } catch (...) {
+            deallocate(temp, max_size);
+            throw;
         }
-        
-        // Deallocate the old memory
-        delete[] _items;
-        
-        // Update members to point to the new array
-        _items = temp;
+        count_resize(max_size);
+        deallocate(_items, _allocated_size);
 
         // Reset indices for the new non-circular layout
-        _first = 0; 
-        _last = _num_items;
+        _items = temp;
+        _first = 0;
+        _last = _num_items == max_size ? 0 : _num_items;
         _allocated_size = max_size;
     }
 
+    // Destroys all elements (the storage is kept)
+    void destroy_all() {
+        if (!std::is_trivially_destructible<T>::value) {
+            for (int i = 0; i < _num_items; ++i) Traits::destroy(_alloc, &_items[slot(i)]);
+        }
+        _num_items = 0;
+        _first = 0;
+        _last = 0;
+    }
+
+    // Copies other's items in FIFO order into our (empty) storage. Only called from
+    // delegating constructors: if a copy throws, the destructor frees what was built.
+    void copy_items(const ArrayQueue& other) {
+        for (int i = 0; i < other._num_items; ++i) enqueue(other._items[other.slot(i)]);
+    }
+
+    // Exchanges everything except the allocators
+    void swap_contents(ArrayQueue& other) noexcept {
+        std::swap(_num_items, other._num_items);
+        std::swap(_allocated_size, other._allocated_size);
+        std::swap(_first, other._first);
+        std::swap(_last, other._last);
+        std::swap(_items, other._items);
+    }
+
+    // Empty queue with exactly n slots (no array for n == 0). The constructors that
+    // build their items one by one delegate here, so that once this has run the
+    // destructor cleans up if an item's constructor throws.
+    ArrayQueue(const Allocator& alloc, int n)
+    : _num_items(0), _allocated_size(n), _first(0), _last(0), _items(nullptr), _alloc(alloc)
+    {
+        _items = allocate(_allocated_size);
+        _stats.peak_capacity = _allocated_size;
+    }
+
 public:
     // Constructors:
-    // Default constructor 
-    ArrayQueue() 
-    /* COMPLETE ... Create an empty queue */
-    : _num_items(0), _allocated_size(10), _first(0), _last(0), _items(new std::string[10])
+    // Default constructor: empty queue with room for 10 items
+    ArrayQueue() : ArrayQueue(10) {}
+
+    // Empty queue with memory allocated to store 'allocated_size' items
+    explicit ArrayQueue(int allocated_size, const Allocator& alloc = Allocator())
+    : ArrayQueue(alloc, allocated_size > 0 ? allocated_size : 1) // Ensure minimum allocation size is 1
+    {}
+
+    // Empty queue (room for 10 items) using alloc
+    explicit ArrayQueue(const Allocator& alloc) : ArrayQueue(10, alloc) {}
+
+    Allocator get_allocator() const { return _alloc; }
+
+    // Destructor: destroys the items and deallocates the array
+    ~ArrayQueue() {
+        destroy_all();
+        deallocate(_items, _allocated_size);
+    }
+
+    // Copy Constructor (Performs a deep copy, compacted to start at index 0)
+    // The allocator is chosen by select_on_container_copy_construction
+    // (for pmr: the default resource, not other's)
+    ArrayQueue(const ArrayQueue& other)
+    : ArrayQueue(other, Traits::select_on_container_copy_construction(other._alloc))
     {}
 
-    explicit ArrayQueue(int allocated_size) 
-    /* COMPLETE ... Create an empty queue with memory allocated 
-     * to store 'allocated_size' items 
-     */
-    : _num_items(0), _first(0), _last(0)
+    // Deep copy using alloc
+    ArrayQueue(const ArrayQueue& other, const Allocator& alloc)
+    : ArrayQueue(other._allocated_size, alloc)
     {
-        // Ensure minimum allocation size is 1
-        _allocated_size = (allocated_size > 0) ? allocated_size : 1;
-        _items = new std::string[_allocated_size];
+        copy_items(other);
     }
 
-    // Destructor:
-    ~ArrayQueue() {
-        // COMPLETE: Deallocate the dynamically allocated array
-        delete[] _items;
+    // Copy Assignment Operator (Using the copy-and-swap idiom)
+    // Keeps our allocator unless it propagates on copy assignment
+    ArrayQueue& operator=(const ArrayQueue& other) {
+        if (this == &other) return *this;
+        constexpr bool propagate = Traits::propagate_on_container_copy_assignment::value;
+        ArrayQueue temp(other, propagate ? other._alloc : _alloc); // Create a temporary copy
+        swap_contents(temp);
+        _stats.peak_capacity = std::max(_stats.peak_capacity, _allocated_size);
+        if constexpr (propagate) std::swap(_alloc, temp._alloc); // temp frees our old array with its allocator
+        return *this;
+        // temp's destructor safely cleans up the old resources of *this
     }
 
-    // Add an item to the queue 
-    void enqueue(const std::string& item) {
-        if (_num_items == _allocated_size) resize(2*_allocated_size);
-        _items[_last++] = item; 
-        if (_last == _allocated_size) _last = 0; // wrap 
-        _num_items++; 
+    // Move Constructor (Transfers resource ownership; the allocator moves along)
+    ArrayQueue(ArrayQueue&& other) noexcept
+    : _num_items(other._num_items),
+      _allocated_size(other._allocated_size),
+      _first(other._first),
+      _last(other._last),
+      _items(other._items), // Steal the pointer
+      _alloc(std::move(other._alloc)),
+      _policy(std::move(other._policy)),
+      _stats(other._stats)
+    {
+        // Leave the source empty, valid and destructible
+        other._num_items = 0;
+        other._allocated_size = 0;
+        other._first = 0;
+        other._last = 0;
+        other._items = nullptr; // Prevent double-free
     }
 
-    // Remove the item that was least recently added 
+    // Move with a given allocator: steals the array (and its stats) if alloc == other's
+    // allocator, otherwise moves the items one by one into memory from alloc
+    ArrayQueue(ArrayQueue&& other, const Allocator& alloc)
+    : ArrayQueue(alloc, alloc == other._alloc ? 0 : std::max(other._allocated_size, 1))
+    {
+        if (_alloc == other._alloc) {
+            swap_contents(other); // other gets our empty state
+            _stats = other._stats;
+        } else {
+            for (int i = 0; i < other._num_items; ++i) enqueue(std::move(other._items[other.slot(i)]));
+            other.destroy_all();
+        }
+        _stats.peak_capacity = std::max(_stats.peak_capacity, _allocated_size);
+    }
+
+    // Move Assignment Operator (Transfers resource ownership)
+    // With an allocator that does not propagate on move assignment and differs from
+    // ours, the items are moved one by one into our memory instead
+    ArrayQueue& operator=(ArrayQueue&& other)
+        noexcept(Traits::propagate_on_container_move_assignment::value || Traits::is_always_equal::value) {
+        if (this != &other) {
+            if constexpr (Traits::propagate_on_container_move_assignment::value) {
+                ArrayQueue temp(std::move(other));
+                swap_contents(temp); // temp releases our old resources
+                std::swap(_alloc, temp._alloc);
+            } else {
+                ArrayQueue temp(std::move(other), _alloc);
+                swap_contents(temp);
+            }
+            _stats.peak_capacity = std::max(_stats.peak_capacity, _allocated_size);
+        }
+        return *this;
+    }
+
+    // Exchanges contents; allocators are exchanged only if they propagate on swap
+    // (otherwise they must be equal, as for the standard containers)
+    void swap(ArrayQueue& other) noexcept {
+        swap_contents(other);
+        if constexpr (Traits::propagate_on_container_swap::value) std::swap(_alloc, other._alloc);
+    }
+
+    // Construct an item in place at the back of the queue; returns a reference to it
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        if (_num_items == _allocated_size) {
+            // Construct the new item before relocating the others: args may refer to one of them
+            int new_size = _policy.grow(_allocated_size);
+            T* temp = allocate(new_size);
+            try {
+                Traits::construct(_alloc, temp + _num_items, std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(temp, new_size);
+                throw;
+            }
+            try {
+                relocate_to(temp); // the queue is unchanged if this throws
+            } catch (...) {
+                Traits::destroy(_alloc, temp + _num_items);
+                deallocate(temp, new_size);
+                throw;
+            }
+            count_resize(new_size);
+            deallocate(_items, _allocated_size);
+            _items = temp;
+            _first = 0;
+            _allocated_size = new_size;
+            _last = _num_items;
+        } else {
+            Traits::construct(_alloc, _items + _last, std::forward<Args>(args)...);
+        }
+        T& item = _items[_last++];
+        if (_last == _allocated_size) _last = 0; // wrap
+        _num_items++;
+        return item;
+    }
+
+    // Add an item to the queue (copied, or moved from an rvalue)
+    void enqueue(const T& item) { emplace(item); }
+    void enqueue(T&& item) { emplace(std::move(item)); }
+
+    // Remove the item that was least recently added
     void dequeue() {
         if (_num_items == 0) {
-            // Optional: Handle attempt to dequeue from an empty queue (e.g., throw exception or print error)
             std::cerr << "Error: Attempt to dequeue from an empty queue." << std::endl;
             return;
         }
+        Traits::destroy(_alloc, &_items[_first]);
         _num_items--;
-        _first++; 
-        if (_first == _allocated_size) _first = 0; // wrap 
-        
-        // Shrink the array if the usage drops to 1/4 of the capacity (but not below a small minimum size, e.g., 4)
-        if (_num_items > 0 && _allocated_size > 4 && _num_items == _allocated_size/4) {
-             resize(_allocated_size/2);
+        _first++;
+        if (_first == _allocated_size) _first = 0; // wrap
+
+        // Shrink the array if the policy says so (by default when the usage drops to 1/4 of the capacity)
+        int new_size = _policy.shrink(_num_items, _allocated_size);
+        if (new_size < _allocated_size && new_size >= _num_items) {
+             resize(new_size);
         }
     }
 
-    // Access the first item 
-    std::string peek() const {
+    // Remove the item that was least recently added and return it (moved out)
+    T pop() {
+        if (_num_items == 0) {
+            throw std::runtime_error("Attempt to pop from an empty queue.");
+        }
+        T item(std::move(_items[_first]));
+        dequeue();
+        return item;
+    }
+
+    // Access the first item (no copy; valid until the queue is modified)
+    const T& peek() const {
         if (_num_items == 0) {
             throw std::runtime_error("Attempt to peek into an empty queue.");
         }
         return _items[_first];
     }
 
-    // Check if the queue is empty 
+    // Access the i-th item in FIFO order, 0 being the first (i < size(), not checked)
+    const T& operator[](int i) const { return _items[slot(i)]; }
+
+    // Check if the queue is empty
     bool empty() const { return _num_items == 0; }
 
-    // Return the number of elements in the queue 
+    // Return the number of elements in the queue
     int size() const { return _num_items; }
 
     // Helper function for testing (not part of the standard interface)
     int allocated_size() const { return _allocated_size; }
+
+    // Resizes so far, the bytes they moved and the peak capacity
+    const ArrayQueueStats& stats() const { return _stats; }
 };
 
+// ArrayQueue whose memory (and that of its pmr-aware elements) comes from a
+// std::pmr::memory_resource, e.g. PmrArrayQueue<std::pmr::string> q(64, &pool);
+template <typename T>
+using PmrArrayQueue = ArrayQueue<T, std::pmr::polymorphic_allocator<T>>;
+
 #endif // ARRAY_QUEUE_H
@@ -0,0 +1,323 @@
+// ConcurrentQueue.h
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <type_traits>
+#include <utility>     // For std::move, std::forward
+#include <vector>
+#include <stdexcept>
+
+#ifndef CONCURRENT_QUEUE_H
+#define CONCURRENT_QUEUE_H
+
+// Unbounded lock-free multi-producer/multi-consumer FIFO queue
+// (the fetch-and-add array queue of Ramalhete and Correia).
+//
+// The queue is a linked list of segments of BlockSize slots. Producers claim a slot
+// of the tail segment with fetch_add on its enqueue index, consumers claim a slot of
+// the head segment with fetch_add on its dequeue index, so in the common case an
+// operation costs one atomic increment and one atomic exchange, and threads never
+// wait for each other. A consumer that claims a slot before its producer has filled
+// it marks the slot as taken; the producer then retries with a new slot. When the tail
+// segment is full a producer links a new one (the element is already in its first
+// slot), and consumers unlink the head segment once all its slots are claimed.
+//
+// Unlinked segments are reclaimed with hazard pointers: a segment is reused only after
+// no thread announces it. Each thread borrows a hazard record for the duration of an
+// operation; the record also keeps the thread's retired segments and a small free
+// list of segments ready for reuse, so a steady-state queue does not allocate.
+template <typename T, int BlockSize = 256>
+class ConcurrentQueue {
+    static_assert(BlockSize > 0, "ConcurrentQueue block size must be positive");
+
+private:
+    enum SlotState : uint32_t { EMPTY = 0, WRITTEN = 1, TAKEN = 2 };
+
+    struct Slot {
+        std::atomic<uint32_t> state;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T* value() { return reinterpret_cast<T*>(&storage); }
+    };
+
+    struct Segment {
+        alignas(64) std::atomic<int> deq_index; // next slot to claim for a dequeue
+        alignas(64) std::atomic<int> enq_index; // next slot to claim for an enqueue
+        std::atomic<Segment*> next;
+        Slot slots[BlockSize];
+
+        void reset() {
+            deq_index.store(0, std::memory_order_relaxed);
+            enq_index.store(0, std::memory_order_relaxed);
+            next.store(nullptr, std::memory_order_relaxed);
+            for (Slot& s : slots) s.state.store(EMPTY, std::memory_order_relaxed);
+        }
+    };
+
+    // Per-thread state, borrowed for the duration of one operation
+    struct HazardRecord {
+        std::atomic<Segment*> hazard;   // segment this thread may be accessing
+        std::atomic<bool> active;       // borrowed by a thread
+        HazardRecord* next;             // all records of this queue (never removed)
+        std::vector<Segment*> retired;  // unlinked, possibly still in use by others
+        std::vector<Segment*> free;     // no longer in use, ready for reuse
+    };
+
+    static const int FREE_LIST_SIZE = 4; // segments kept per record for reuse
+
+    alignas(64) std::atomic<Segment*> _head;
+    alignas(64) std::atomic<Segment*> _tail;
+    alignas(64) std::atomic<HazardRecord*> _records;
+    std::atomic<int> _num_records;
+    std::atomic<int> _num_segments; // allocated, whether linked, retired or free
+    uint64_t _id;                   // unique per queue, for the per-thread record cache
+
+    static uint64_t next_id() {
+        static std::atomic<uint64_t> counter(0);
+        return ++counter;
+    }
+
+    // Borrows a hazard record: the one this thread used last if it is free,
+    // else any free one, else a new one
+    HazardRecord* acquire_record() {
+        struct Hint { uint64_t queue_id; HazardRecord* record; };
+        static thread_local Hint hint = {0, nullptr};
+        if (hint.queue_id == _id && !hint.record->active.exchange(true, std::memory_order_acquire)) {
+            return hint.record;
+        }
+        HazardRecord* r = _records.load(std::memory_order_acquire);
+        for (; r; r = r->next) {
+            if (!r->active.load(std::memory_order_relaxed) && !r->active.exchange(true, std::memory_order_acquire)) break;
+        }
+        if (!r) {
+            r = new HazardRecord;
+            r->hazard.store(nullptr, std::memory_order_relaxed);
+            r->active.store(true, std::memory_order_relaxed);
+            r->next = _records.load(std::memory_order_relaxed);
+            while (!_records.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed)) {}
+            _num_records.fetch_add(1, std::memory_order_relaxed);
+        }
+        hint = Hint{_id, r};
+        return r;
+    }
+
+    void release_record(HazardRecord* r) {
+        r->hazard.store(nullptr, std::memory_order_release);
+        r->active.store(false, std::memory_order_release);
+    }
+
+    struct RecordGuard {
+        ConcurrentQueue* queue;
+        HazardRecord* record;
+        explicit RecordGuard(ConcurrentQueue* q) : queue(q), record(q->acquire_record()) {}
+        ~RecordGuard() { queue->release_record(record); }
+    };
+
+    // Loads src and announces it in r, re-reading until the announcement is stable
+    static Segment* protect(HazardRecord* r, const std::atomic<Segment*>& src) {
+        Segment* s = src.load(std::memory_order_acquire);
+        for (;;) {
+            r->hazard.store(s, std::memory_order_seq_cst);
+            Segment* again = src.load(std::memory_order_seq_cst);
+            if (again == s) return s;
+            s = again;
+        }
+    }
+
+    Segment* new_segment(HazardRecord* r) {
+        Segment* s;
+        if (!r->free.empty()) {
+            s = r->free.back();
+            r->free.pop_back();
+        } else {
+            s = new Segment;
+            _num_segments.fetch_add(1, std::memory_order_relaxed);
+        }
+        s->reset();
+        return s;
+    }
+
+    void recycle(HazardRecord* r, Segment* s) {
+        if ((int)r->free.size() < FREE_LIST_SIZE) {
+            r->free.push_back(s);
+        } else {
+            delete s;
+            _num_segments.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Queues an unlinked segment for reuse once no hazard pointer refers to it
+    void retire(HazardRecord* r, Segment* s) {
+        r->retired.push_back(s);
+        if ((int)r->retired.size() < 2 * _num_records.load(std::memory_order_relaxed)) return;
+
+        std::vector<Segment*> hazards;
+        for (HazardRecord* h = _records.load(std::memory_order_acquire); h; h = h->next) {
+            if (Segment* p = h->hazard.load(std::memory_order_seq_cst)) hazards.push_back(p);
+        }
+        std::vector<Segment*> still_used;
+        for (Segment* old : r->retired) {
+            bool used = false;
+            for (Segment* p : hazards) used = used || p == old;
+            if (used) still_used.push_back(old); else recycle(r, old);
+        }
+        r->retired.swap(still_used);
+    }
+
+    // Moves item into the queue; item is left valid (moved back) on a failed attempt
+    void push(T item) {
+        RecordGuard guard(this);
+        HazardRecord* r = guard.record;
+        for (;;) {
+            Segment* tail = protect(r, _tail);
+            int index = tail->enq_index.fetch_add(1, std::memory_order_relaxed);
+            if (index < BlockSize) {
+                Slot& slot = tail->slots[index];
+                ::new (static_cast<void*>(slot.value())) T(std::move(item));
+                uint32_t expected = EMPTY;
+                if (slot.state.compare_exchange_strong(expected, WRITTEN, std::memory_order_acq_rel)) return;
+                // A consumer gave up on this slot first: take the item back and retry
+                take_back(item, slot.value());
+                continue;
+            }
+
+            // Tail segment full: link a new one, or help move _tail to the one linked by another thread
+            if (tail != _tail.load(std::memory_order_acquire)) continue;
+            Segment* next = tail->next.load(std::memory_order_acquire);
+            if (next) {
+                _tail.compare_exchange_strong(tail, next, std::memory_order_acq_rel);
+                continue;
+            }
+            Segment* segment = new_segment(r);
+            ::new (static_cast<void*>(segment->slots[0].value())) T(std::move(item));
+            segment->slots[0].state.store(WRITTEN, std::memory_order_relaxed);
+            segment->enq_index.store(1, std::memory_order_relaxed);
+            Segment* expected = nullptr;
+            if (tail->next.compare_exchange_strong(expected, segment, std::memory_order_acq_rel)) {
+                _tail.compare_exchange_strong(tail, segment, std::memory_order_acq_rel);
+                return;
+            }
+            take_back(item, segment->slots[0].value());
+            recycle(r, segment);
+        }
+    }
+
+    static void take_back(T& item, T* stored) {
+        item.~T();
+        ::new (static_cast<void*>(&item)) T(std::move(*stored));
+        stored->~T();
+    }
+
+public:
+    // Constructors:
+    // Empty queue with one segment
+    ConcurrentQueue() : _records(nullptr), _num_records(0), _num_segments(1), _id(next_id()) {
+        Segment* s = new Segment;
+        s->reset();
+        _head.store(s, std::memory_order_relaxed);
+        _tail.store(s, std::memory_order_relaxed);
+    }
+
+    // Destructor: no other thread may be using the queue
+    ~ConcurrentQueue() {
+        for (Segment* s = _head.load(std::memory_order_relaxed); s; ) {
+            for (Slot& slot : s->slots) {
+                if (slot.state.load(std::memory_order_relaxed) == WRITTEN) slot.value()->~T();
+            }
+            Segment* next = s->next.load(std::memory_order_relaxed);
+            delete s;
+            s = next;
+        }
+        for (HazardRecord* r = _records.load(std::memory_order_relaxed); r; ) {
+            for (Segment* s : r->retired) delete s;
+            for (Segment* s : r->free) delete s;
+            HazardRecord* next = r->next;
+            delete r;
+            r = next;
+        }
+    }
+
+    // Prevent copy and move operations (other threads may hold references)
+    ConcurrentQueue(const ConcurrentQueue&) = delete;
+    ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+    ConcurrentQueue(ConcurrentQueue&&) = delete;
+    ConcurrentQueue& operator=(ConcurrentQueue&&) = delete;
+
+    // Add an item to the queue (never fails, never blocks)
+    void enqueue(const T& item) { push(T(item)); }
+    void enqueue(T&& item) { push(std::move(item)); }
+
+    // Construct an item and add it to the queue
+    template <typename... Args>
+    void emplace(Args&&... args) { push(T(std::forward<Args>(args)...)); }
+
+    // Remove the least recently added item into item; returns false if the queue was empty.
+    // This replaces peek() + dequeue(): with several consumers, the item seen by a peek
+    // may be taken by another thread before the dequeue.
+    bool try_dequeue(T& item) {
+        RecordGuard guard(this);
+        HazardRecord* r = guard.record;
+        for (;;) {
+            Segment* head = protect(r, _head);
+            if (head->deq_index.load(std::memory_order_acquire) >= head->enq_index.load(std::memory_order_acquire) &&
+                head->next.load(std::memory_order_acquire) == nullptr) {
+                return false;
+            }
+            int index = head->deq_index.fetch_add(1, std::memory_order_relaxed);
+            if (index < BlockSize) {
+                Slot& slot = head->slots[index];
+                if (slot.state.exchange(TAKEN, std::memory_order_acq_rel) == WRITTEN) {
+                    item = std::move(*slot.value());
+                    slot.value()->~T();
+                    return true;
+                }
+                continue; // the producer of this slot has not finished: it will retry elsewhere
+            }
+
+            // Head segment used up: unlink it (moving _tail first if it lags behind)
+            Segment* next = head->next.load(std::memory_order_acquire);
+            if (!next) return false;
+            Segment* tail = head;
+            _tail.compare_exchange_strong(tail, next, std::memory_order_acq_rel);
+            if (_head.compare_exchange_strong(head, next, std::memory_order_acq_rel)) {
+                r->hazard.store(nullptr, std::memory_order_release);
+                retire(r, head);
+            }
+        }
+    }
+
+    // Remove the least recently added item and return it
+    // Throws std::runtime_error if the queue is empty
+    T pop() {
+        T item;
+        if (!try_dequeue(item)) {
+            throw std::runtime_error("Attempt to pop from an empty queue.");
+        }
+        return item;
+    }
+
+    // Remove the item that was least recently added
+    void dequeue() {
+        T item;
+        if (!try_dequeue(item)) {
+            std::cerr << "Error: Attempt to dequeue from an empty queue." << std::endl;
+        }
+    }
+
+    // Check if the queue is empty (only a snapshot while other threads are running)
+    bool empty() {
+        RecordGuard guard(this);
+        Segment* head = protect(guard.record, _head);
+        return head->deq_index.load(std::memory_order_acquire) >= head->enq_index.load(std::memory_order_acquire) &&
+               head->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+    // Segments currently allocated (for testing and monitoring)
+    int allocated_segments() const { return _num_segments.load(std::memory_order_relaxed); }
+
+    static constexpr int block_size() { return BlockSize; }
+};
+
+#endif // CONCURRENT_QUEUE_H
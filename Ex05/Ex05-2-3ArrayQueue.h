@@ -4,32 +4,78 @@
 #include <iostream>
 #include <utility> // Necessary for std::swap and std::move
 #include <stdexcept>
+#include <atomic>
 
 #ifndef ARRAY_QUEUE_H
 #define ARRAY_QUEUE_H
 
+// Copies are copy-on-write snapshots: a copy shares the array of the original
+// through a reference-counted buffer, so copying a queue of any size is O(1).
+// A shared buffer is never modified. The first enqueue (or resize) on either side
+// copies the items into a private buffer; dequeue only moves this queue's own
+// indices, so it needs no copy. The count is atomic and nothing is locked, so a
+// snapshot can be read by another thread while the original keeps changing.
 class ArrayQueue {
 private:
+    // Array shared by a queue and its copies
+    struct Buffer {
+        std::atomic<int> refs;   // number of queues using the array
+        std::string* items;
+    };
+
     int _num_items;        // Number of elements currently in the queue
     int _allocated_size;   // Size of the allocated memory (capacity)
     int _first;            // Index of the front element (the next one to dequeue)
     int _last;             // Index of the next available slot
-    std::string* _items;   // The dynamic array holding the elements
-    
-    // Helper to dynamically change the size of the underlying array. Copies data to a new array.
+    Buffer* _buffer;       // The dynamic array holding the elements (nullptr after a move)
+
+    static Buffer* new_buffer(int size) {
+        Buffer* b = new Buffer;
+        b->refs.store(1, std::memory_order_relaxed);
+        try {
+            b->items = new std::string[size];
+        } catch (...) {
+            delete b;
+            throw;
+        }
+        return b;
+    }
+
+    // Drops this queue's reference; the last queue using the array frees it
+    void release() {
+        if (_buffer && _buffer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete[] _buffer->items;
+            delete _buffer;
+        }
+        _buffer = nullptr;
+    }
+
+    // True if a copy still uses our array (acquire: see the items as a released copy left them)
+    bool shared() const {
+        return _buffer && _buffer->refs.load(std::memory_order_acquire) > 1;
+    }
+
+    // Helper to dynamically change the size of the underlying array. Copies data to a new
+    // (private) array, or moves it if no copy shares the old one.
     void resize(int max_size) {
         if (max_size == 0) max_size = 1; // Ensure minimum size
 
-        std::string* temp = new std::string[max_size];
+        Buffer* temp = new_buffer(max_size);
         
         // Copy elements in logical FIFO order, resolving the circular layout
-        for (int i = 0; i < _num_items; ++i) {
-            temp[i] = _items[(i + _first) % _allocated_size];
+        if (shared()) {
+            for (int i = 0; i < _num_items; ++i) {
+                temp->items[i] = _buffer->items[(i + _first) % _allocated_size];
+            }
+        } else {
+            for (int i = 0; i < _num_items; ++i) {
+                temp->items[i] = std::move(_buffer->items[(i + _first) % _allocated_size]);
+            }
         }
         
-        delete[] _items;
+        release();
         
-        _items = temp;
+        _buffer = temp;
         // Reset indices for the new non-circular layout
         _first = 0; 
         _last = _num_items;
@@ -39,7 +85,7 @@ private:
 public:
     // Default constructor
     ArrayQueue() 
-    : _num_items(0), _allocated_size(10), _first(0), _last(0), _items(new std::string[10])
+    : _num_items(0), _allocated_size(10), _first(0), _last(0), _buffer(new_buffer(10))
     {}
 
     // Constructor to specify initial capacity
@@ -47,27 +93,23 @@ public:
     : _num_items(0), _first(0), _last(0)
     {
         _allocated_size = (allocated_size > 0) ? allocated_size : 1; // Ensure minimum size
-        _items = new std::string[_allocated_size];
+        _buffer = new_buffer(_allocated_size);
     }
 
-    // Destructor: Free the dynamically allocated memory
+    // Destructor: Free the dynamically allocated memory (if no copy still uses it)
     ~ArrayQueue() {
-        delete[] _items;
+        release();
     }
 
-    // Copy Constructor (Performs a deep copy)
+    // Copy Constructor (O(1): shares other's array until one of them enqueues)
     ArrayQueue(const ArrayQueue& other) 
     : _num_items(other._num_items),
       _allocated_size(other._allocated_size),
-      _first(0), // The copy starts at index 0 for simplicity
-      _last(other._num_items)
+      _first(other._first),
+      _last(other._last),
+      _buffer(other._buffer)
     {
-        _items = new std::string[_allocated_size];
-
-        // Copy all elements
-        for (int i = 0; i < _num_items; ++i) {
-            _items[i] = other._items[(i + other._first) % other._allocated_size];
-        }
+        if (_buffer) _buffer->refs.fetch_add(1, std::memory_order_relaxed);
     }
 
     // Copy Assignment Operator (Using the copy-and-swap idiom)
@@ -79,7 +121,7 @@ public:
         std::swap(_allocated_size, temp._allocated_size);
         std::swap(_first, temp._first);
         std::swap(_last, temp._last);
-        std::swap(_items, temp._items); // Swap the raw pointers!
+        std::swap(_buffer, temp._buffer); // Swap the raw pointers!
 
         return *this;
         // temp's destructor safely cleans up the old resources of *this
@@ -91,42 +133,46 @@ public:
       _allocated_size(other._allocated_size),
       _first(other._first),
       _last(other._last),
-      _items(other._items) // Steal the pointer
+      _buffer(other._buffer) // Steal the pointer
     {
         // Nullify the source to leave it in a valid, destructible state
         other._num_items = 0;
         other._allocated_size = 0;
         other._first = 0;
         other._last = 0;
-        other._items = nullptr; // Prevent double-free
+        other._buffer = nullptr; // Prevent double-free
     }
 
     // Move Assignment Operator (Transfers resource ownership)
     ArrayQueue& operator=(ArrayQueue&& other) noexcept {
         if (this != &other) {
-            delete[] _items; // Release own resources 
+            release(); // Release own resources
 
             // Move data from the source
             _num_items = other._num_items;
             _allocated_size = other._allocated_size;
             _first = other._first;
             _last = other._last;
-            _items = other._items;
+            _buffer = other._buffer;
 
             // Nullify the source
             other._num_items = 0;
             other._allocated_size = 0;
             other._first = 0;
             other._last = 0;
-            other._items = nullptr;
+            other._buffer = nullptr;
         }
         return *this;
     }
 
     // Add an element to the back of the queue
     void enqueue(const std::string& item) {
-        if (_num_items == _allocated_size) resize(2*_allocated_size); // Double capacity if full
-        _items[_last++] = item; 
+        if (_num_items == _allocated_size) {
+            resize(2*_allocated_size); // Double capacity if full
+        } else if (shared()) {
+            resize(_allocated_size); // Copy on write
+        }
+        _buffer->items[_last++] = item; 
         if (_last == _allocated_size) _last = 0; // Wrap around
         _num_items++; 
     }
@@ -152,7 +198,7 @@ public:
         if (_num_items == 0) {
             throw std::runtime_error("Attempt to peek into an empty queue.");
         }
-        return _items[_first];
+        return _buffer->items[_first];
     }
 
     // Check if the queue is empty
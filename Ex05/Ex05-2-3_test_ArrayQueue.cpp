@@ -4,11 +4,15 @@
 #include <stdexcept>
 #include <cassert>
 #include <utility> 
+#include <memory>
+#include <memory_resource>
+#include <chrono>
+#include <thread>
 
 using namespace std;
 
 // Helper function to display the current state of the queue
-void print_queue_status(const ArrayQueue& q, const string& name) {
+void print_queue_status(const ArrayQueue<string>& q, const string& name) {
     cout << "[" << name << "] Size: " << q.size() 
          << ", Capacity: " << q.allocated_size()
          << (q.empty() ? " (EMPTY)" : "") << endl;
@@ -36,7 +40,7 @@ void run_test(const string& test_name, void (*test_func)()) {
 
 // Test basic Enqueue, Dequeue, and Peek operations
 void test_basic_operations() {
-    ArrayQueue q; 
+    ArrayQueue<string> q; 
     assert(q.empty() && q.size() == 0);
 
     q.enqueue("Alpha");
@@ -55,7 +59,7 @@ void test_basic_operations() {
 
 // Test capacity doubling upon reaching limit
 void test_resizing() {
-    ArrayQueue q(2); 
+    ArrayQueue<string> q(2); 
 
     q.enqueue("One");
     q.enqueue("Two");
@@ -76,7 +80,7 @@ void test_resizing() {
 
 // Test wrap-around behavior of indices in the circular array
 void test_wrap_around() {
-    ArrayQueue q(4); 
+    ArrayQueue<string> q(4); 
     
     // Move indices to start wrap-around test
     q.enqueue("A"); 
@@ -99,7 +103,7 @@ void test_wrap_around() {
 
 // Test capacity halving when usage is low
 void test_shrinking() {
-    ArrayQueue q(8);
+    ArrayQueue<string> q(8);
     cout << "Initial Capacity: " << q.allocated_size() << endl;
 
     // Fill to size 7
@@ -131,11 +135,11 @@ void test_shrinking() {
 
 // Test the deep copy behavior of the copy constructor
 void test_copy_constructor() {
-    ArrayQueue q1(4);
+    ArrayQueue<string> q1(4);
     q1.enqueue("One"); q1.enqueue("Two"); q1.dequeue(); 
     q1.enqueue("Three"); q1.enqueue("Four"); 
     
-    ArrayQueue q2 = q1; // Call copy constructor
+    ArrayQueue<string> q2 = q1; // Call copy constructor
 
     // Verify q1 and q2 match initially
     assert(q1.size() == q2.size());
@@ -151,9 +155,9 @@ void test_copy_constructor() {
 
 // Test the copy assignment operator, including self-assignment
 void test_copy_assignment() {
-    ArrayQueue q1(2);
+    ArrayQueue<string> q1(2);
     q1.enqueue("A"); q1.enqueue("B");
-    ArrayQueue q2(10);
+    ArrayQueue<string> q2(10);
     q2.enqueue("Y"); 
 
     q2 = q1; // Copy assignment
@@ -173,11 +177,11 @@ void test_copy_assignment() {
 
 // Test the transfer of ownership using the move constructor
 void test_move_constructor() {
-    ArrayQueue q1(8);
+    ArrayQueue<string> q1(8);
     q1.enqueue("MoveMe1"); q1.enqueue("MoveMe2"); q1.dequeue(); 
     int original_capacity = q1.allocated_size();
     
-    ArrayQueue q2 = std::move(q1); // Call move constructor
+    ArrayQueue<string> q2 = std::move(q1); // Call move constructor
     cout << "--- q2 = std::move(q1) done ---" << endl;
 
     // Verify q2 has the data and capacity
@@ -193,9 +197,9 @@ void test_move_constructor() {
 
 // Test the transfer of ownership using the move assignment operator
 void test_move_assignment() {
-    ArrayQueue q1(8);
+    ArrayQueue<string> q1(8);
     q1.enqueue("SourceA"); q1.enqueue("SourceB");
-    ArrayQueue q2(4);
+    ArrayQueue<string> q2(4);
     q2.enqueue("TargetX");
     
     q2 = std::move(q1); // Move assignment
@@ -214,6 +218,276 @@ void test_move_assignment() {
 }
 
 
+// --- Generic ArrayQueue<T> Tests ---
+
+// Counts copies and moves, and has no default constructor
+struct Tracked {
+    static int copies, moves, alive;
+    int value;
+    explicit Tracked(int v) : value(v) { alive++; }
+    Tracked(const Tracked& o) : value(o.value) { copies++; alive++; }
+    Tracked(Tracked&& o) noexcept : value(o.value) { moves++; alive++; }
+    ~Tracked() { alive--; }
+};
+int Tracked::copies = 0, Tracked::moves = 0, Tracked::alive = 0;
+
+// Copies and moves throw once 'budget' of them have been made
+struct Fragile {
+    static int budget, alive;
+    int value;
+    explicit Fragile(int v) : value(v) { alive++; }
+    Fragile(const Fragile& o) : value(o.value) { spend(); alive++; }
+    Fragile(Fragile&& o) : value(o.value) { spend(); alive++; } // may throw: resizes copy
+    ~Fragile() { alive--; }
+    static void spend() {
+        if (budget == 0) throw runtime_error("Fragile: no copies left");
+        budget--;
+    }
+};
+int Fragile::budget = 0, Fragile::alive = 0;
+
+// Test that a copy that throws partway destroys and frees what it built (no leak, no
+// double free) and leaves the source intact
+void test_exception_safety() {
+    ArrayQueue<Fragile> q(16);
+    for (int i = 0; i < 10; ++i) q.emplace(i);
+
+    Fragile::budget = 5;
+    bool threw = false;
+    try { ArrayQueue<Fragile> copy(q); } catch (const runtime_error&) { threw = true; }
+    assert(threw && Fragile::alive == 10 && q.size() == 10 && q.peek().value == 0);
+
+    // Moving into another resource moves the items one by one
+    std::pmr::unsynchronized_pool_resource pool_a, pool_b;
+    PmrArrayQueue<Fragile> a(16, &pool_a);
+    for (int i = 0; i < 10; ++i) a.emplace(i);
+    Fragile::budget = 5;
+    threw = false;
+    try { PmrArrayQueue<Fragile> b(std::move(a), &pool_b); } catch (const runtime_error&) { threw = true; }
+    assert(threw && Fragile::alive == 20 && a.size() == 10);
+
+    // Growing copies the items (the move may throw): a failure keeps the queue as it was
+    ArrayQueue<Fragile> full(4);
+    for (int i = 0; i < 4; ++i) full.emplace(i);
+    Fragile::budget = 2; // the new item and one relocated copy
+    threw = false;
+    try { full.emplace(Fragile(99)); } catch (const runtime_error&) { threw = true; }
+    assert(threw && Fragile::alive == 24 && full.size() == 4 && full.allocated_size() == 4);
+    for (int i = 0; i < 4; ++i) {
+        assert(full.peek().value == i);
+        full.dequeue();
+    }
+}
+
+// Test that slots hold no objects and that resizing moves instead of copying
+void test_uninitialized_storage() {
+    {
+        ArrayQueue<Tracked> q(2);
+        assert(Tracked::alive == 0); // no default-constructed slots
+
+        for (int i = 0; i < 100; ++i) q.emplace(i); // several resizes
+        cout << "--- 100 emplaces: " << Tracked::copies << " copies, " << Tracked::moves << " moves ---" << endl;
+        assert(Tracked::alive == 100 && Tracked::copies == 0);
+        assert(q.peek().value == 0);
+
+        for (int i = 0; i < 90; ++i) q.dequeue(); // several shrinks
+        assert(Tracked::alive == 10 && Tracked::copies == 0);
+        assert(q.peek().value == 90);
+    }
+    assert(Tracked::alive == 0); // destructor destroys the remaining items
+}
+
+// Test emplace, rvalue enqueue and pop with a move-only type
+void test_move_only() {
+    ArrayQueue<unique_ptr<string>> q(1);
+    q.enqueue(unique_ptr<string>(new string("first")));
+    q.emplace(new string("second"));
+    unique_ptr<string> third(new string("third"));
+    q.enqueue(std::move(third));
+    assert(!third && q.size() == 3);
+
+    assert(*q.peek() == "first");
+    unique_ptr<string> p = q.pop();
+    assert(*p == "first" && q.size() == 2);
+    assert(*q.pop() == "second");
+    assert(*q.pop() == "third" && q.empty());
+
+    bool threw = false;
+    try { q.pop(); } catch (const runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+// Test that enqueueing one of the queue's own items survives the resize it triggers
+void test_self_reference() {
+    ArrayQueue<string> q(2);
+    q.enqueue(string(100, 'x'));
+    q.enqueue("y");
+    q.enqueue(q.peek()); // full: the argument lives in the array being replaced
+    assert(q.size() == 3 && q.allocated_size() == 4);
+    q.dequeue();
+    q.dequeue();
+    assert(q.peek() == string(100, 'x'));
+
+    // peek returns a reference, not a copy
+    assert(&q.peek() == &q.peek());
+}
+
+// Test a trivially copyable element type (relocated with memcpy) across wrap-around
+void test_trivial_type() {
+    ArrayQueue<int> q(4);
+    q.enqueue(0); q.enqueue(1); q.dequeue(); q.dequeue();
+    for (int i = 2; i < 7; ++i) q.enqueue(i); // wraps, then resizes
+    for (int i = 2; i < 7; ++i) {
+        assert(q.peek() == i);
+        q.dequeue();
+    }
+    assert(q.empty());
+}
+
+
+// --- Allocator Tests ---
+
+// Test that a PmrArrayQueue and its pmr::string items live entirely in the given resource
+void test_pmr_resource() {
+    char buffer[1 << 16];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    {
+        PmrArrayQueue<std::pmr::string> q(2, &arena);
+        for (int i = 0; i < 20; ++i) {
+            q.emplace("a string well beyond the small-string buffer #" + to_string(i)); // resizes too
+        }
+        assert(q.get_allocator().resource() == &arena);
+        assert(q.peek().get_allocator().resource() == &arena); // items use the queue's resource
+        for (int i = 0; i < 15; ++i) q.dequeue();
+        assert(q.size() == 5 && q.peek().substr(q.peek().size() - 3) == "#15");
+    }
+    std::pmr::set_default_resource(previous);
+    // Reaching here means nothing fell back to the (null) default resource
+}
+
+// Test allocator propagation on copy, move and assignment
+void test_pmr_propagation() {
+    std::pmr::unsynchronized_pool_resource pool_a, pool_b;
+    PmrArrayQueue<std::pmr::string> a(4, &pool_a);
+    a.enqueue("first item that needs heap storage in its resource");
+    a.enqueue("second item that needs heap storage in its resource");
+
+    // Copy construction: polymorphic_allocator does not propagate, the copy uses the default resource
+    PmrArrayQueue<std::pmr::string> copy(a);
+    assert(copy.get_allocator().resource() == std::pmr::get_default_resource());
+    assert(copy.peek() == a.peek());
+
+    // Copy assignment keeps the target's resource
+    PmrArrayQueue<std::pmr::string> b(4, &pool_b);
+    b = a;
+    assert(b.get_allocator().resource() == &pool_b && b.size() == 2);
+    assert(b.peek().get_allocator().resource() == &pool_b);
+
+    // Move construction takes the source's resource (and its array)
+    const std::pmr::string* front = &a.peek();
+    PmrArrayQueue<std::pmr::string> moved(std::move(a));
+    assert(moved.get_allocator().resource() == &pool_a && &moved.peek() == front);
+    assert(a.empty());
+
+    // Move assignment between different resources moves item by item into the target's
+    PmrArrayQueue<std::pmr::string> c(4, &pool_b);
+    c = std::move(moved);
+    assert(c.get_allocator().resource() == &pool_b && c.size() == 2);
+    assert(c.peek().get_allocator().resource() == &pool_b && &c.peek() != front);
+    assert(c.peek() == "first item that needs heap storage in its resource");
+}
+
+// Test the resize counters
+void test_resize_stats() {
+    ArrayQueue<int> q(4);
+    assert(q.stats().resizes == 0 && q.stats().peak_capacity == 4);
+    for (int i = 0; i < 16; ++i) q.enqueue(i); // 4 -> 8 (moves 4 items) -> 16 (moves 8)
+    for (int i = 0; i < 12; ++i) q.dequeue();  // 16 -> 8 at 4 items (moves 4)
+    assert(q.allocated_size() == 8);
+    assert(q.stats().resizes == 3 && q.stats().bytes_moved == 16 * (long long)sizeof(int));
+    assert(q.stats().peak_capacity == 16);
+
+    // Copies start their own history; moves take it along
+    ArrayQueue<int> copy(q);
+    assert(copy.stats().resizes == 0);
+    ArrayQueue<int> moved(std::move(q));
+    assert(moved.stats().resizes == 3);
+    ArrayQueue<int> stolen(std::move(moved), std::allocator<int>());
+    assert(stolen.stats().resizes == 3 && stolen.stats().peak_capacity == 16);
+
+    // Moving into another resource copies the items into a new array of the same size
+    std::pmr::unsynchronized_pool_resource pool_a, pool_b;
+    PmrArrayQueue<int> a(4, &pool_a);
+    for (int i = 0; i < 5; ++i) a.enqueue(i);
+    PmrArrayQueue<int> b(std::move(a), &pool_b);
+    assert(b.allocated_size() == 8 && b.stats().peak_capacity == 8);
+}
+
+// Test the growth policies: 1.5x growth with a floor, and shrinking with hysteresis
+void test_growth_policies() {
+    ArrayQueue<int, std::allocator<int>, GeometricGrowth<3, 2, 8>> slow(8);
+    for (int i = 0; i < 13; ++i) slow.enqueue(i);
+    assert(slow.allocated_size() == 18); // 8 -> 12 -> 18
+    while (!slow.empty()) slow.dequeue();
+    assert(slow.allocated_size() == 8);  // 18 -> 9 at 4 items -> 8 (not 4) at 2 items
+
+    // A queue oscillating between 4 and 9 items thrashes with the default policy,
+    // while a delayed shrink keeps the grown array
+    ArrayQueue<int> thrash(8);
+    ArrayQueue<int, std::allocator<int>, DelayedShrink<GeometricGrowth<2, 1, 4>, 64>> steady(8);
+    for (int cycle = 0; cycle < 100; ++cycle) {
+        while (thrash.size() < 9) thrash.enqueue(cycle);
+        while (thrash.size() > 4) thrash.dequeue();
+        while (steady.size() < 9) steady.enqueue(cycle);
+        while (steady.size() > 4) steady.dequeue();
+    }
+    assert(thrash.stats().resizes == 200);
+    assert(steady.stats().resizes == 1 && steady.allocated_size() == 16);
+
+    // ... but still shrinks once the queue stays small
+    ArrayQueue<int, std::allocator<int>, DelayedShrink<GeometricGrowth<2, 1, 4>, 3>> delayed(64);
+    for (int i = 0; i < 20; ++i) delayed.enqueue(i);
+    for (int i = 0; i < 4; ++i) delayed.dequeue(); // 16 items: first request
+    assert(delayed.allocated_size() == 64);
+    delayed.dequeue();
+    delayed.dequeue();                             // third request in a row
+    assert(delayed.allocated_size() == 32 && delayed.peek() == 6);
+
+    // Timed shrink: only after the queue has stayed small for 20 ms
+    ArrayQueue<int, std::allocator<int>, TimedShrink<GeometricGrowth<2, 1, 4>, 20>> timed(64);
+    for (int i = 0; i < 20; ++i) timed.enqueue(i);
+    for (int i = 0; i < 10; ++i) timed.dequeue();
+    assert(timed.allocated_size() == 64);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    timed.dequeue();
+    assert(timed.allocated_size() == 32 && timed.size() == 9);
+
+    // The default policy keeps a large initial capacity while the queue stays small,
+    // but the wrappers over it shrink once it has stayed below a quarter
+    ArrayQueue<string> reserved(1000);
+    reserved.enqueue("a");
+    reserved.enqueue("b");
+    reserved.dequeue();
+    assert(reserved.allocated_size() == 1000);
+
+    ArrayQueue<int, std::allocator<int>, DelayedShrink<DoublingGrowth, 3>> delayed_doubling(64);
+    for (int i = 0; i < 20; ++i) delayed_doubling.enqueue(i);
+    for (int i = 0; i < 5; ++i) delayed_doubling.dequeue(); // 16 and 15 items: two requests
+    assert(delayed_doubling.allocated_size() == 64);
+    delayed_doubling.dequeue();                             // third request in a row
+    assert(delayed_doubling.allocated_size() == 32 && delayed_doubling.peek() == 6);
+
+    ArrayQueue<int, std::allocator<int>, TimedShrink<DoublingGrowth, 20>> timed_doubling(64);
+    for (int i = 0; i < 20; ++i) timed_doubling.enqueue(i);
+    for (int i = 0; i < 10; ++i) timed_doubling.dequeue();
+    assert(timed_doubling.allocated_size() == 64);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    timed_doubling.dequeue();
+    assert(timed_doubling.allocated_size() == 32 && timed_doubling.size() == 9);
+}
+
+
 int main(void) {
     cout << "Starting ArrayQueue Test Suite..." << endl;
     
@@ -228,5 +502,17 @@ int main(void) {
     run_test("Move Constructor (Transfer Ownership)", test_move_constructor);
     run_test("Move Assignment Operator (Transfer Ownership)", test_move_assignment);
 
+    run_test("Uninitialized Storage (No Copies on Resize)", test_uninitialized_storage);
+    run_test("Move-only Type (Emplace, Pop)", test_move_only);
+    run_test("Enqueue of an Own Item During Resize", test_self_reference);
+    run_test("Trivially Copyable Type (Wrap-around, Resize)", test_trivial_type);
+    run_test("Exception Safety (Throwing Copies)", test_exception_safety);
+
+    run_test("PMR Memory Resource", test_pmr_resource);
+    run_test("PMR Allocator Propagation", test_pmr_propagation);
+
+    run_test("Resize Statistics", test_resize_stats);
+    run_test("Growth Policies (1.5x, Floor, Delayed and Timed Shrink)", test_growth_policies);
+
     return 0;
 }
@@ -0,0 +1,116 @@
+// Ex05-2-3_test_snapshot.cpp: copy-on-write copies of the string ArrayQueue
+#include "Ex05-2-3ArrayQueue.h"
+#include <chrono>
+#include <thread>
+#include <cassert>
+
+using namespace std;
+
+// Wrapper to run a specific test function and catch/display exceptions
+void run_test(const string& test_name, void (*test_func)()) {
+    cout << "\n--- Starting Test: " << test_name << " ---" << endl;
+    try {
+        test_func();
+        cout << "--- Test Passed: " << test_name << " ---" << endl;
+    } catch (const exception& e) {
+        cerr << "--- Test FAILED: " << test_name << " ---" << endl;
+        cerr << "   Exception caught: " << e.what() << endl;
+    } catch (...) {
+        cerr << "--- Test FAILED: " << test_name << " ---" << endl;
+        cerr << "   Unknown error caught." << endl;
+    }
+}
+
+// A snapshot keeps its items whichever side changes afterwards
+void test_independence() {
+    ArrayQueue q(4);
+    for (int i = 0; i < 3; ++i) q.enqueue("Item" + to_string(i));
+
+    ArrayQueue snapshot = q; // Shares q's array
+    q.dequeue();             // Only moves q's indices
+    q.enqueue("Item3");      // Copies q's items into a new array
+    q.enqueue("Item4");      // Grows the new array
+    assert(snapshot.size() == 3 && snapshot.peek() == "Item0");
+    assert(q.size() == 4 && q.peek() == "Item1");
+
+    ArrayQueue other;
+    other = snapshot;        // Copy assignment shares too
+    snapshot.enqueue("Snap");
+    for (int i = 0; i < 3; ++i) {
+        assert(other.peek() == "Item" + to_string(i));
+        other.dequeue();
+    }
+    assert(other.empty() && snapshot.size() == 4);
+
+    ArrayQueue moved = std::move(snapshot);
+    assert(moved.size() == 4 && snapshot.empty());
+    snapshot.enqueue("Reused"); // A moved-from queue is usable again
+    assert(snapshot.peek() == "Reused");
+}
+
+// Dequeuing from both sides down to the shrink threshold never disturbs the other side
+void test_shrink_while_shared() {
+    ArrayQueue q;
+    for (int i = 0; i < 100; ++i) q.enqueue(to_string(i));
+    ArrayQueue snapshot = q;
+    for (int i = 0; i < 90; ++i) q.dequeue();
+    assert(q.peek() == "90" && q.allocated_size() < snapshot.allocated_size());
+    for (int i = 0; i < 100; ++i) {
+        assert(snapshot.peek() == to_string(i));
+        snapshot.dequeue();
+    }
+    assert(snapshot.empty() && q.size() == 10);
+}
+
+// Taking a snapshot of 10M items costs the same as of 10 (timings printed, not asserted)
+void test_snapshot_cost() {
+    using Clock = chrono::steady_clock;
+    ArrayQueue q;
+    for (int i = 0; i < 10000000; ++i) q.enqueue("payload");
+
+    auto t0 = Clock::now();
+    ArrayQueue snapshot = q;
+    double snapshot_us = chrono::duration<double, micro>(Clock::now() - t0).count();
+    assert(snapshot.size() == q.size());
+
+    t0 = Clock::now();
+    q.enqueue("first write");
+    double write_ms = chrono::duration<double, milli>(Clock::now() - t0).count();
+    cout << "   snapshot of 10M items: " << snapshot_us << " us; first enqueue after it (copies): "
+         << write_ms << " ms" << endl;
+}
+
+// A reader drains a snapshot in another thread while the writer keeps going
+void test_concurrent_reader() {
+    ArrayQueue q;
+    for (int i = 0; i < 1000; ++i) q.enqueue(to_string(i));
+
+    for (int round = 0; round < 100; ++round) {
+        ArrayQueue snapshot = q;
+        int first = stoi(q.peek());
+        thread reader([s = std::move(snapshot), first]() mutable {
+            for (int i = first; !s.empty(); ++i) {
+                assert(s.peek() == to_string(i));
+                s.dequeue();
+            }
+        });
+        for (int i = 0; i < 50; ++i) {
+            q.enqueue(to_string(first + 1000 + i));
+            q.dequeue();
+        }
+        reader.join();
+    }
+    assert(q.size() == 1000 && q.peek() == "5000");
+}
+
+
+int main(void) {
+    cout << "Starting ArrayQueue Snapshot Test Suite..." << endl;
+
+    run_test("Independent Copies", test_independence);
+    run_test("Shrinking While Shared", test_shrink_while_shared);
+    run_test("Snapshot Cost (10M items)", test_snapshot_cost);
+    run_test("Reader Thread on a Snapshot", test_concurrent_reader);
+
+    return 0;
+}
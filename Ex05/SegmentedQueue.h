@@ -0,0 +1,216 @@
+// SegmentedQueue.h
+
+#include <iostream>
+#include <new>
+#include <type_traits>
+#include <utility>     // For std::move, std::forward, std::swap
+#include <stdexcept>
+
+#ifndef SEGMENTED_QUEUE_H
+#define SEGMENTED_QUEUE_H
+
+// Default number of elements per block: about 4 KiB, and at least 16
+template <typename T>
+constexpr int segmented_queue_block_size() {
+    return sizeof(T) * 16 >= 4096 ? 16 : int(4096 / sizeof(T));
+}
+
+// Unbounded FIFO queue stored as a singly linked list of fixed-size blocks
+// (an unrolled list). Same interface as ArrayQueue<T>, but it never relocates:
+// enqueue allocates at most one block when the tail block is full, and dequeue
+// frees at most one block when the head block is used up. Both are O(1) in the
+// worst case, not just amortized, and references to queued items stay valid.
+// One emptied block is kept as a spare so that a queue oscillating around a block
+// boundary does not call the allocator on every operation.
+template <typename T, int BlockSize = segmented_queue_block_size<T>()>
+class SegmentedQueue {
+    static_assert(BlockSize > 0, "SegmentedQueue block size must be positive");
+
+private:
+    struct Block {
+        Block* next;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[BlockSize];
+
+        T* at(int i) { return reinterpret_cast<T*>(&slots[i]); }
+    };
+
+    int _num_items;    // number of items in the queue
+    int _num_blocks;   // blocks allocated, including the spare
+    Block* _head;      // block holding the first element (nullptr if no block yet)
+    Block* _tail;      // block receiving the next element
+    int _first;        // index of the first element in _head
+    int _last;         // index of the next available slot in _tail
+    Block* _spare;     // empty block kept for reuse (or nullptr)
+
+    Block* new_block() {
+        Block* b = _spare;
+        if (b) {
+            _spare = nullptr;
+        } else {
+            b = new Block;
+            _num_blocks++;
+        }
+        b->next = nullptr;
+        return b;
+    }
+
+    void release_block(Block* b) {
+        if (!_spare) {
+            _spare = b;
+        } else {
+            delete b;
+            _num_blocks--;
+        }
+    }
+
+    // Destroys all elements and frees all blocks
+    void clear_all() {
+        while (_num_items > 0) dequeue();
+        delete _head;
+        delete _spare;
+        _head = _tail = _spare = nullptr;
+        _num_blocks = 0;
+        _first = _last = 0;
+    }
+
+public:
+    // Constructors:
+    // Empty queue; the first block is allocated by the first enqueue
+    SegmentedQueue()
+    : _num_items(0), _num_blocks(0), _head(nullptr), _tail(nullptr), _first(0), _last(0), _spare(nullptr)
+    {}
+
+    // Destructor: destroys the items and frees the blocks
+    ~SegmentedQueue() { clear_all(); }
+
+    // Copy Constructor (Performs a deep copy)
+    SegmentedQueue(const SegmentedQueue& other) : SegmentedQueue() {
+        try {
+            Block* b = other._head;
+            int i = other._first;
+            for (int n = 0; n < other._num_items; ++n) {
+                if (i == BlockSize) {
+                    b = b->next;
+                    i = 0;
+                }
+                enqueue(*b->at(i++));
+            }
+        } catch (...) {
+            clear_all();
+            throw;
+        }
+    }
+
+    // Copy Assignment Operator (Using the copy-and-swap idiom)
+    SegmentedQueue& operator=(const SegmentedQueue& other) {
+        SegmentedQueue temp = other;
+        swap(temp);
+        return *this;
+    }
+
+    // Move Constructor (Transfers the blocks)
+    SegmentedQueue(SegmentedQueue&& other) noexcept : SegmentedQueue() {
+        swap(other);
+    }
+
+    // Move Assignment Operator (Transfers the blocks)
+    SegmentedQueue& operator=(SegmentedQueue&& other) noexcept {
+        if (this != &other) {
+            SegmentedQueue temp(std::move(other));
+            swap(temp); // temp releases our old blocks
+        }
+        return *this;
+    }
+
+    void swap(SegmentedQueue& other) noexcept {
+        std::swap(_num_items, other._num_items);
+        std::swap(_num_blocks, other._num_blocks);
+        std::swap(_head, other._head);
+        std::swap(_tail, other._tail);
+        std::swap(_first, other._first);
+        std::swap(_last, other._last);
+        std::swap(_spare, other._spare);
+    }
+
+    // Construct an item in place at the back of the queue; returns a reference to it
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        if (!_tail) {
+            _head = _tail = new_block();
+        } else if (_last == BlockSize) {
+            // Construct into the new block before linking it, so a throwing
+            // constructor leaves the queue unchanged
+            Block* b = new_block();
+            try {
+                ::new (static_cast<void*>(b->at(0))) T(std::forward<Args>(args)...);
+            } catch (...) {
+                release_block(b);
+                throw;
+            }
+            _tail->next = b;
+            _tail = b;
+            _last = 1;
+            _num_items++;
+            return *b->at(0);
+        }
+        T* item = ::new (static_cast<void*>(_tail->at(_last))) T(std::forward<Args>(args)...);
+        _last++;
+        _num_items++;
+        return *item;
+    }
+
+    // Add an item to the queue (copied, or moved from an rvalue)
+    void enqueue(const T& item) { emplace(item); }
+    void enqueue(T&& item) { emplace(std::move(item)); }
+
+    // Remove the item that was least recently added
+    void dequeue() {
+        if (_num_items == 0) {
+            std::cerr << "Error: Attempt to dequeue from an empty queue." << std::endl;
+            return;
+        }
+        _head->at(_first)->~T();
+        _first++;
+        _num_items--;
+        if (_num_items == 0) {
+            // Keep the (only) block and start over at its beginning
+            _first = _last = 0;
+        } else if (_first == BlockSize) {
+            Block* used = _head;
+            _head = _head->next;
+            _first = 0;
+            release_block(used);
+        }
+    }
+
+    // Remove the item that was least recently added and return it (moved out)
+    T pop() {
+        if (_num_items == 0) {
+            throw std::runtime_error("Attempt to pop from an empty queue.");
+        }
+        T item(std::move(*_head->at(_first)));
+        dequeue();
+        return item;
+    }
+
+    // Access the first item (no copy)
+    const T& peek() const {
+        if (_num_items == 0) {
+            throw std::runtime_error("Attempt to peek into an empty queue.");
+        }
+        return *_head->at(_first);
+    }
+
+    // Check if the queue is empty
+    bool empty() const { return _num_items == 0; }
+
+    // Return the number of elements in the queue
+    int size() const { return _num_items; }
+
+    // Number of element slots allocated (blocks * BlockSize, including the spare)
+    int allocated_size() const { return _num_blocks * BlockSize; }
+
+    static constexpr int block_size() { return BlockSize; }
+};
+
+#endif // SEGMENTED_QUEUE_H
@@ -0,0 +1,342 @@
+// SpillingQueue.h
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>     // For std::memcpy, std::strerror
+#include <algorithm>   // For std::min, std::max
+#include <functional>  // For std::less
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include "ArrayQueue.h"
+
+#ifndef SPILLING_QUEUE_H
+#define SPILLING_QUEUE_H
+
+// FIFO queue of strings that keeps at most about 'memory_budget' bytes in memory and
+// spills the rest to disk, for backlogs larger than RAM.
+//
+// The queue is three parts in FIFO order: an in-memory head (items about to be
+// dequeued), spilled items in append-only segment files, and an in-memory tail
+// (items just enqueued). The budget is split in thirds: the head, the tail and the
+// I/O buffer. An item costs its slot in the queue array (sizeof(std::string), with
+// room for the array to double) plus the heap block of a string too long for its
+// inline buffer. When the next item would push the tail past its third, the tail is
+// written to the newest segment file in buffer-sized pwrite()s, so an enqueue never
+// copies the rest of the backlog. When the head runs empty it is refilled from the
+// oldest file up to its third, reading a buffer's worth at a time (one pread()), or
+// takes over the tail if nothing is spilled. Records are a 64-bit length followed by
+// the bytes. A single item larger than a third is still accepted on its own.
+//
+// Segment files are created in 'directory' and unlinked right away, so the disk space
+// is released when a file has been read back, when the queue is destroyed, or when
+// the process dies. A new file is started once the current one holds
+// 'segment_bytes'. Throws std::runtime_error if a file cannot be created, written or read;
+// after a failed write (e.g. a full disk) the enqueue that triggered it has no effect
+// and every item already accepted is still queued.
+class SpillingQueue {
+private:
+    struct SegmentFile {
+        int fd;
+        uint64_t write_pos;  // end of the data written so far
+        uint64_t read_pos;   // start of the data not read back yet
+    };
+
+    ArrayQueue<std::string> _head;  // first items, dequeued from here
+    ArrayQueue<std::string> _tail;  // last items, enqueued here
+    std::deque<SegmentFile> _files; // spilled items, oldest file first
+    size_t _head_bytes;             // heap bytes of the strings in _head (see heap_bytes)
+    size_t _tail_bytes;             // heap bytes of the strings in _tail
+    uint64_t _num_items;            // in all three parts
+    uint64_t _spilled_items;        // items in _files
+    uint64_t _spilled_bytes;        // file bytes not read back yet
+    size_t _memory_budget;
+    uint64_t _segment_bytes;
+    std::string _directory;
+    std::vector<char> _buffer;      // reused for writing and reading records
+    size_t _cache_begin;            // _buffer[_cache_begin, _cache_end) holds the bytes of the
+    size_t _cache_end;              // oldest file from its read_pos on, read but not loaded yet
+
+    static constexpr size_t RECORD_HEADER = sizeof(uint64_t);
+    static constexpr size_t HEAP_OVERHEAD = 2 * sizeof(size_t); // malloc header and rounding, about
+
+    size_t part_budget() const { return std::max<size_t>(_memory_budget / 3, RECORD_HEADER); }
+
+    // Heap memory of an item besides its slot: none for a string in its inline buffer
+    static size_t heap_bytes(const std::string& item) {
+        const char* self = reinterpret_cast<const char*>(&item);
+        std::less<const char*> before;
+        if (!before(item.data(), self) && before(item.data(), self + sizeof(std::string))) return 0;
+        return item.capacity() + 1 + HEAP_OVERHEAD;
+    }
+
+    // True if a part holding 'bytes' heap bytes stays within its third after adding an
+    // item of 'extra' heap bytes (a full array doubles)
+    bool fits(const ArrayQueue<std::string>& part, size_t bytes, size_t extra) const {
+        size_t slots = (size_t)part.allocated_size();
+        if ((size_t)part.size() == slots) slots = std::max<size_t>(2 * slots, 1);
+        return bytes + extra + slots * sizeof(std::string) <= part_budget();
+    }
+
+    // Makes _buffer at least n bytes (exactly n when it grows) and drops the cached records
+    void reserve_buffer(size_t n) {
+        _cache_begin = _cache_end = 0;
+        if (_buffer.size() >= n) return;
+        std::vector<char>().swap(_buffer); // free the old buffer before allocating the new one
+        _buffer.resize(n);
+    }
+
+    [[noreturn]] static void fail(const std::string& what) {
+        throw std::runtime_error("SpillingQueue: " + what + ": " + std::strerror(errno));
+    }
+
+    static void write_all(int fd, const char* data, size_t n, uint64_t offset) {
+        while (n > 0) {
+            ssize_t done = ::pwrite(fd, data, n, (off_t)offset);
+            if (done < 0) {
+                if (errno == EINTR) continue;
+                fail("cannot write segment file");
+            }
+            data += done;
+            n -= (size_t)done;
+            offset += (uint64_t)done;
+        }
+    }
+
+    static void read_all(int fd, char* data, size_t n, uint64_t offset) {
+        while (n > 0) {
+            ssize_t done = ::pread(fd, data, n, (off_t)offset);
+            if (done < 0 && errno == EINTR) continue;
+            if (done <= 0) {
+                if (done == 0) errno = EIO; // truncated behind our back
+                fail("cannot read segment file");
+            }
+            data += done;
+            n -= (size_t)done;
+            offset += (uint64_t)done;
+        }
+    }
+
+    void open_file() {
+        std::string path = _directory + "/spillqueue-XXXXXX";
+        int fd = ::mkstemp(&path[0]);
+        if (fd < 0) fail("cannot create segment file in " + _directory);
+        ::unlink(path.c_str()); // the data lives as long as the descriptor
+        _files.push_back(SegmentFile{fd, 0, 0});
+    }
+
+    void close_file() {
+        ::close(_files.front().fd);
+        _files.pop_front();
+    }
+
+    // Writes n bytes at 'offset' of the newest file. If that fails (e.g. the disk is
+    // full), the file is cut back to its last complete record, or dropped if it holds
+    // none, before the error is thrown.
+    void write_newest(const char* data, size_t n, uint64_t offset) {
+        SegmentFile& f = _files.back();
+        try {
+            write_all(f.fd, data, n, offset);
+        } catch (...) {
+            if (f.read_pos == f.write_pos) {
+                ::close(f.fd);
+                _files.pop_back();
+            } else if (::ftruncate(f.fd, (off_t)f.write_pos) != 0) {
+                // Best effort: the bytes past write_pos are never read
+            }
+            throw;
+        }
+    }
+
+    // Writes the whole tail to the newest segment file, a buffer at a time. Items leave
+    // the tail only once their records are written, so if a write fails every item is
+    // still queued, in order.
+    void spill() {
+        if (_files.empty() || _files.back().write_pos >= _segment_bytes) open_file();
+        reserve_buffer(part_budget()); // the tail's records are smaller than its memory
+        size_t used = 0;
+        int pending = 0; // first items of the tail whose records are in _buffer
+
+        // The records of the pending items (and 'extra' bytes written after them) are on
+        // disk: take the items out of the tail
+        auto commit = [&](size_t extra) {
+            SegmentFile& f = _files.back();
+            f.write_pos += used + extra;
+            _spilled_bytes += used + extra;
+            _spilled_items += pending;
+            for (; pending > 0; --pending) {
+                _tail_bytes -= heap_bytes(_tail.peek());
+                _tail.dequeue();
+            }
+            used = 0;
+        };
+        auto flush = [&] {
+            write_newest(_buffer.data(), used, _files.back().write_pos);
+            commit(0);
+        };
+
+        while (pending < _tail.size()) {
+            if (used + RECORD_HEADER + _tail[pending].size() > _buffer.size()) flush(); // may resize _tail
+            const std::string& item = _tail[pending];
+            uint64_t length = item.size();
+            std::memcpy(_buffer.data() + used, &length, RECORD_HEADER);
+            used += RECORD_HEADER;
+            pending++;
+            if (item.size() > _buffer.size() - used) {
+                // Larger than the buffer: written straight from the string
+                uint64_t pos = _files.back().write_pos;
+                write_newest(_buffer.data(), used, pos);
+                write_newest(item.data(), item.size(), pos + used);
+                commit(item.size());
+            } else {
+                std::memcpy(_buffer.data() + used, item.data(), item.size());
+                used += item.size();
+            }
+        }
+        flush();
+    }
+
+    // Moves records from the oldest file into the (empty) head until it fills its third.
+    // Records read past that stay cached in _buffer for the next load.
+    void load() {
+        SegmentFile& f = _files.front();
+        uint64_t length = 0;
+        bool cached = _cache_end - _cache_begin >= RECORD_HEADER;
+        if (cached) {
+            std::memcpy(&length, _buffer.data() + _cache_begin, RECORD_HEADER);
+            cached = length <= _cache_end - _cache_begin - RECORD_HEADER;
+        }
+        if (!cached) {
+            size_t n = (size_t)std::min<uint64_t>(f.write_pos - f.read_pos, part_budget());
+            reserve_buffer(n);
+            read_all(f.fd, _buffer.data(), n, f.read_pos);
+            _cache_end = n;
+        }
+
+        size_t pos = _cache_begin;
+        while (_cache_end - pos >= RECORD_HEADER) {
+            std::memcpy(&length, _buffer.data() + pos, RECORD_HEADER);
+            if (length > _cache_end - pos - RECORD_HEADER) break;
+            std::string item(_buffer.data() + pos + RECORD_HEADER, (size_t)length);
+            size_t bytes = heap_bytes(item);
+            if (!_head.empty() && !fits(_head, _head_bytes, bytes)) break;
+            _head.enqueue(std::move(item));
+            _head_bytes += bytes;
+            pos += RECORD_HEADER + (size_t)length;
+        }
+        size_t consumed = pos - _cache_begin;
+        _cache_begin = pos;
+        if (consumed == 0) {
+            // A single record larger than the buffer: read it on its own
+            std::memcpy(&length, _buffer.data() + pos, RECORD_HEADER);
+            std::string item((size_t)length, '\0');
+            if (length > 0) read_all(f.fd, &item[0], (size_t)length, f.read_pos + RECORD_HEADER);
+            _head_bytes += heap_bytes(item);
+            _head.enqueue(std::move(item));
+            consumed = RECORD_HEADER + (size_t)length;
+            _cache_begin = _cache_end = 0;
+        }
+        _spilled_items -= _head.size();
+        _spilled_bytes -= consumed;
+        f.read_pos += consumed;
+        if (f.read_pos == f.write_pos) close_file(); // also the file being written: the next spill starts a new one
+    }
+
+    // Keeps the head non-empty while the queue is not
+    void refill() {
+        if (!_head.empty()) return;
+        if (!_files.empty()) {
+            load();
+        } else if (!_tail.empty()) {
+            _head.swap(_tail);
+            std::swap(_head_bytes, _tail_bytes);
+        }
+    }
+
+public:
+    // Constructors:
+    // Empty queue keeping about 'memory_budget' bytes of items in memory and
+    // spilling the rest into files of about 'segment_bytes' bytes in 'directory'
+    explicit SpillingQueue(size_t memory_budget = 64 << 20, uint64_t segment_bytes = 1 << 30,
+                           const std::string& directory = "/tmp")
+    : _head_bytes(0), _tail_bytes(0), _num_items(0), _spilled_items(0), _spilled_bytes(0),
+      _memory_budget(memory_budget), _segment_bytes(segment_bytes > 0 ? segment_bytes : 1), _directory(directory),
+      _cache_begin(0), _cache_end(0)
+    {}
+
+    // Destructor: closes (and so deletes) the segment files
+    ~SpillingQueue() {
+        while (!_files.empty()) close_file();
+    }
+
+    // Prevent copy and move operations (the queue owns open files)
+    SpillingQueue(const SpillingQueue&) = delete;
+    SpillingQueue& operator=(const SpillingQueue&) = delete;
+    SpillingQueue(SpillingQueue&&) = delete;
+    SpillingQueue& operator=(SpillingQueue&&) = delete;
+
+    // Add an item to the queue (copied, or moved from an rvalue)
+    void enqueue(const std::string& item) { enqueue(std::string(item)); }
+    void enqueue(std::string&& item) {
+        size_t bytes = heap_bytes(item); // the same after the move
+        if (!_tail.empty() && !fits(_tail, _tail_bytes, bytes)) spill();
+        _tail.enqueue(std::move(item));
+        _tail_bytes += bytes;
+        _num_items++;
+        refill();
+    }
+
+    // Remove the item that was least recently added
+    void dequeue() {
+        if (_num_items == 0) {
+            std::cerr << "Error: Attempt to dequeue from an empty queue." << std::endl;
+            return;
+        }
+        _head_bytes -= heap_bytes(_head.peek());
+        _head.dequeue();
+        _num_items--;
+        refill();
+    }
+
+    // Remove the item that was least recently added and return it (moved out)
+    std::string pop() {
+        if (_num_items == 0) {
+            throw std::runtime_error("Attempt to pop from an empty queue.");
+        }
+        std::string item = _head.pop();
+        _head_bytes -= heap_bytes(item);
+        _num_items--;
+        refill();
+        return item;
+    }
+
+    // Access the first item (no copy; valid until the queue is modified)
+    const std::string& peek() const {
+        if (_num_items == 0) {
+            throw std::runtime_error("Attempt to peek into an empty queue.");
+        }
+        return _head.peek();
+    }
+
+    // Check if the queue is empty
+    bool empty() const { return _num_items == 0; }
+
+    // Return the number of elements in the queue (may exceed INT_MAX)
+    uint64_t size() const { return _num_items; }
+
+    // For testing and monitoring: bytes held in memory (queue arrays, string heap
+    // blocks with an estimated allocator overhead, and the I/O buffer), items and
+    // bytes waiting on disk, and open segment files
+    size_t memory_bytes() const {
+        return _head_bytes + _tail_bytes + _buffer.size() +
+               (size_t)(_head.allocated_size() + _tail.allocated_size()) * sizeof(std::string);
+    }
+    uint64_t spilled_items() const { return _spilled_items; }
+    uint64_t spilled_bytes() const { return _spilled_bytes; }
+    int segment_files() const { return (int)_files.size(); }
+};
+
+#endif // SPILLING_QUEUE_H
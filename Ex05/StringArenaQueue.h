@@ -0,0 +1,130 @@
+// StringArenaQueue.h
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstring>     // For std::memcpy
+#include <algorithm>   // For std::max
+#include <stdexcept>
+#include "ArrayQueue.h"
+
+#ifndef STRING_ARENA_QUEUE_H
+#define STRING_ARENA_QUEUE_H
+
+// FIFO queue of strings whose characters live in one circular byte arena.
+//
+// enqueue appends the bytes at the arena's tail and records only (offset, length)
+// in an ArrayQueue of slots; dequeue releases the oldest bytes, so space is
+// reclaimed in FIFO order and no per-item heap allocation ever happens. peek
+// returns a std::string_view into the arena instead of a copy.
+//
+// Each item is stored contiguously: if it does not fit between the tail and the end
+// of the arena it starts over at offset 0, and the gap at the end stays unused until
+// the head passes it. When neither place has room the arena doubles (or grows to fit
+// the item) and the live bytes are compacted into the new one.
+class StringArenaQueue {
+private:
+    struct Slot {
+        size_t offset;  // first byte in the arena
+        size_t length;  // number of bytes
+    };
+
+    ArrayQueue<Slot> _slots;   // one slot per item, in FIFO order
+    std::vector<char> _arena;  // circular byte buffer
+    size_t _head;              // offset of the first item's bytes (if any)
+    size_t _tail;              // offset where the next item's bytes go
+    size_t _used;              // bytes of the queued items (gaps not counted)
+
+    // Offset for n more bytes, or npos if the arena has no contiguous room.
+    // While the data wraps (tail < head) the tail must stay strictly below the head,
+    // so that tail == head only ever means "empty".
+    size_t find_room(size_t n) const {
+        if (_slots.empty()) return n <= _arena.size() ? 0 : std::string::npos;
+        if (_tail >= _head) {
+            if (_arena.size() - _tail >= n) return _tail;
+            if (n < _head) return 0;
+        } else if (_head - _tail > n) {
+            return _tail;
+        }
+        return std::string::npos;
+    }
+
+    // Moves the queued bytes to the start of a larger arena, rewriting the slots
+    void grow(size_t min_free) {
+        std::vector<char> arena(std::max(2 * _arena.size(), _used + min_free + 1));
+        size_t pos = 0;
+        for (int i = _slots.size(); i > 0; --i) {
+            Slot s = _slots.pop();
+            std::memcpy(arena.data() + pos, _arena.data() + s.offset, s.length);
+            _slots.enqueue(Slot{pos, s.length});
+            pos += s.length;
+        }
+        _arena.swap(arena);
+        _head = 0;
+        _tail = pos;
+    }
+
+public:
+    // Constructors:
+    // Empty queue with an arena of 'arena_bytes' bytes and room for 'slots' items
+    explicit StringArenaQueue(size_t arena_bytes = 4096, int slots = 16)
+    : _slots(slots), _arena(arena_bytes > 0 ? arena_bytes : 1), _head(0), _tail(0), _used(0)
+    {}
+
+    // Add an item to the queue (its bytes are copied into the arena)
+    void enqueue(std::string_view item) {
+        size_t offset = find_room(item.size());
+        if (offset == std::string::npos) {
+            grow(item.size());
+            offset = _tail;
+        }
+        if (_slots.empty()) _head = offset;
+        if (!item.empty()) std::memcpy(_arena.data() + offset, item.data(), item.size());
+        _slots.enqueue(Slot{offset, item.size()});
+        _tail = offset + item.size();
+        _used += item.size();
+    }
+
+    // Remove the item that was least recently added; its bytes become free
+    void dequeue() {
+        if (_slots.empty()) {
+            std::cerr << "Error: Attempt to dequeue from an empty queue." << std::endl;
+            return;
+        }
+        _used -= _slots.peek().length;
+        _slots.dequeue();
+        if (_slots.empty()) {
+            _head = _tail = 0; // start over at the beginning of the arena
+        } else {
+            _head = _slots.peek().offset; // skips the gap at the end after a wrap
+        }
+    }
+
+    // Access the first item without copying (valid until the queue is modified)
+    std::string_view peek() const {
+        if (_slots.empty()) {
+            throw std::runtime_error("Attempt to peek into an empty queue.");
+        }
+        const Slot& s = _slots.peek();
+        return std::string_view(_arena.data() + s.offset, s.length);
+    }
+
+    // Remove the first item and return a copy of it
+    std::string pop() {
+        std::string item(peek());
+        dequeue();
+        return item;
+    }
+
+    // Check if the queue is empty
+    bool empty() const { return _slots.empty(); }
+
+    // Return the number of elements in the queue
+    int size() const { return _slots.size(); }
+
+    // Arena size and bytes of the queued items (for testing and monitoring)
+    size_t arena_capacity() const { return _arena.size(); }
+    size_t arena_used() const { return _used; }
+};
+
+#endif // STRING_ARENA_QUEUE_H
@@ -6,7 +6,7 @@
 
 using namespace std;
 
-void print_queue_status(const ArrayQueue& q, const string& name) {
+void print_queue_status(const ArrayQueue<string>& q, const string& name) {
     cout << "[" << name << "] Size: " << q.size() 
          << ", Capacity: " << q.allocated_size()
          << (q.empty() ? " (EMPTY)" : "") << endl;
@@ -32,7 +32,7 @@ void run_test(const string& test_name, void (*test_func)()) {
 
 // Test Case 1: Basic Enqueue, Dequeue, Peek, and Empty/Size
 void test_basic_operations() {
-    ArrayQueue q; // Default constructor test
+    ArrayQueue<string> q; // Default constructor test
     print_queue_status(q, "q");
     assert(q.empty() && q.size() == 0);
 
@@ -59,7 +59,7 @@ void test_basic_operations() {
 
 // Test Case 2: Resizing (Doubling Capacity)
 void test_resizing() {
-    ArrayQueue q(2); // Start with capacity 2
+    ArrayQueue<string> q(2); // Start with capacity 2
     print_queue_status(q, "ResizeQueue");
     assert(q.allocated_size() == 2);
 
@@ -92,7 +92,7 @@ void test_resizing() {
 
 // Test Case 3: Circular Array (Wrap-around)
 void test_wrap_around() {
-    ArrayQueue q(4); // Start with capacity 4
+    ArrayQueue<string> q(4); // Start with capacity 4
     
     // Fill up and dequeue some to move _first/_last
     q.enqueue("A"); // _first=0, _last=1
@@ -130,7 +130,7 @@ void test_wrap_around() {
 // Test Case 4: Shrinking (Halving Capacity)
 void test_shrinking() {
     // Start with capacity 8
-    ArrayQueue q(8);
+    ArrayQueue<string> q(8);
     cout << "Initial Capacity: " << q.allocated_size() << endl;
 
     // Fill to size 7 (Capacity 8)
@@ -0,0 +1,133 @@
+// test_ConcurrentQueue.cpp
+#include "ConcurrentQueue.h"
+#include <string>
+#include <memory>
+#include <thread>
+#include <cassert>
+#include <vector>
+#include <atomic>
+
+using namespace std;
+
+// Wrapper to run a specific test function and catch/display exceptions
+void run_test(const string& test_name, void (*test_func)()) {
+    cout << "\n--- Starting Test: " << test_name << " ---" << endl;
+    try {
+        test_func();
+        cout << "--- Test Passed: " << test_name << " ---" << endl;
+    } catch (const exception& e) {
+        cerr << "--- Test FAILED: " << test_name << " ---" << endl;
+        cerr << "   Exception caught: " << e.what() << endl;
+    } catch (...) {
+        cerr << "--- Test FAILED: " << test_name << " ---" << endl;
+        cerr << "   Unknown error caught." << endl;
+    }
+}
+
+// Test basic Enqueue, Dequeue and Pop operations (single thread)
+void test_basic_operations() {
+    ConcurrentQueue<string> q;
+    assert(q.empty());
+
+    q.enqueue("Alpha");
+    q.enqueue("Beta");
+    q.emplace(3, 'c');
+    assert(!q.empty());
+
+    string item;
+    assert(q.try_dequeue(item) && item == "Alpha");
+    q.dequeue();
+    assert(q.pop() == "ccc");
+    assert(q.empty() && !q.try_dequeue(item));
+
+    q.dequeue(); // Test dequeuing from an empty queue (should print error/no crash)
+    bool thrown = false;
+    try {
+        q.pop();
+    } catch (const runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+// Test FIFO order across segment boundaries and reuse of unlinked segments
+void test_segments() {
+    ConcurrentQueue<int, 4> q;
+    for (int i = 0; i < 100; ++i) q.enqueue(i);
+    assert(q.allocated_segments() == 25);
+    for (int i = 0; i < 100; ++i) assert(q.pop() == i);
+    assert(q.empty());
+
+    // Unlinked segments go to the free list instead of back to the allocator
+    int segments = q.allocated_segments();
+    for (int round = 0; round < 1000; ++round) {
+        for (int i = 0; i < 10; ++i) q.enqueue(i);
+        for (int i = 0; i < 10; ++i) assert(q.pop() == i);
+    }
+    assert(q.allocated_segments() <= segments);
+}
+
+// Test a move-only type and items left in the queue at destruction
+void test_move_only() {
+    ConcurrentQueue<unique_ptr<int>, 2> q;
+    for (int i = 0; i < 5; ++i) q.emplace(new int(i));
+    for (int i = 0; i < 3; ++i) assert(*q.pop() == i);
+    // The destructor frees the remaining two (checked by the leak sanitizer)
+}
+
+// Several producers and consumers: every item is dequeued exactly once,
+// and the items of each producer come out in the order they were enqueued
+void test_mpmc() {
+    const int PRODUCERS = 4, CONSUMERS = 4, PER_PRODUCER = 200000;
+    ConcurrentQueue<long long, 64> q;
+    vector<vector<long long>> received(CONSUMERS);
+    atomic<int> remaining(PRODUCERS * PER_PRODUCER);
+
+    vector<thread> threads;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        threads.emplace_back([&q, p] {
+            for (int i = 0; i < PER_PRODUCER; ++i) q.enqueue((long long)p * PER_PRODUCER + i);
+        });
+    }
+    for (int c = 0; c < CONSUMERS; ++c) {
+        threads.emplace_back([&q, &received, &remaining, c] {
+            long long item;
+            while (remaining.load(memory_order_relaxed) > 0) {
+                if (q.try_dequeue(item)) {
+                    received[c].push_back(item);
+                    remaining.fetch_sub(1, memory_order_relaxed);
+                } else {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+    for (thread& t : threads) t.join();
+
+    vector<char> seen(PRODUCERS * PER_PRODUCER, 0);
+    for (const vector<long long>& items : received) {
+        vector<long long> last(PRODUCERS, -1);
+        for (long long item : items) {
+            assert(!seen[item]);
+            seen[item] = 1;
+            int p = int(item / PER_PRODUCER);
+            assert(item > last[p]);
+            last[p] = item;
+        }
+    }
+    for (char s : seen) assert(s);
+    assert(q.empty());
+    cout << "   " << PRODUCERS * PER_PRODUCER << " items, " << q.allocated_segments() << " segments allocated" << endl;
+}
+
+
+int main(void) {
+    cout << "Starting ConcurrentQueue Test Suite..." << endl;
+
+    run_test("Basic Operations", test_basic_operations);
+    run_test("Segments and Free List", test_segments);
+    run_test("Move-only Type", test_move_only);
+    run_test("Multiple Producers and Consumers", test_mpmc);
+
+    return 0;
+}
@@ -0,0 +1,154 @@
+// test_SegmentedQueue.cpp
+#include "SegmentedQueue.h"
+#include "ArrayQueue.h"
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+// Wrapper to run a specific test function and catch/display exceptions
+void run_test(const string& test_name, void (*test_func)()) {
+    cout << "\n--- Starting Test: " << test_name << " ---" << endl;
+    try {
+        test_func();
+        cout << "--- Test Passed: " << test_name << " ---" << endl;
+    } catch (const exception& e) {
+        cerr << "--- Test FAILED: " << test_name << " ---" << endl;
+        cerr << "   Exception caught: " << e.what() << endl;
+    } catch (...) {
+        cerr << "--- Test FAILED: " << test_name << " ---" << endl;
+        cerr << "   Unknown error caught." << endl;
+    }
+}
+
+// Test basic Enqueue, Dequeue, and Peek operations
+void test_basic_operations() {
+    SegmentedQueue<string> q;
+    assert(q.empty() && q.size() == 0 && q.allocated_size() == 0);
+
+    q.enqueue("Alpha");
+    q.enqueue("Beta");
+    assert(q.peek() == "Alpha" && q.size() == 2);
+
+    q.dequeue();
+    assert(q.peek() == "Beta");
+    assert(q.pop() == "Beta");
+    assert(q.empty());
+
+    q.dequeue(); // Test dequeuing from an empty queue (should print error/no crash)
+    assert(q.empty());
+}
+
+// Test that blocks are added and freed one at a time across block boundaries
+void test_blocks() {
+    SegmentedQueue<int, 4> q;
+    for (int i = 0; i < 10; ++i) q.enqueue(i);
+    assert(q.allocated_size() == 12); // 3 blocks of 4
+
+    // References stay valid while the queue grows
+    const int& front = q.peek();
+    for (int i = 10; i < 100; ++i) q.enqueue(i);
+    assert(&front == &q.peek() && front == 0);
+    assert(q.allocated_size() == 100);
+
+    for (int i = 0; i < 96; ++i) {
+        assert(q.peek() == i);
+        q.dequeue();
+    }
+    // 1 block in use plus 1 spare
+    assert(q.size() == 4 && q.allocated_size() == 8);
+
+    // Oscillating around a block boundary reuses the spare
+    for (int i = 0; i < 10; ++i) {
+        q.enqueue(i);
+        q.dequeue();
+    }
+    assert(q.allocated_size() == 8);
+    assert(q.size() == 4 && q.peek() == 6);
+}
+
+// Test copy and move semantics
+void test_copy_move() {
+    SegmentedQueue<string, 2> q1;
+    for (int i = 0; i < 5; ++i) q1.enqueue("Item" + to_string(i));
+    q1.dequeue();
+
+    SegmentedQueue<string, 2> q2 = q1; // Copy constructor
+    q1.dequeue();
+    assert(q2.size() == 4 && q2.peek() == "Item1" && q1.peek() == "Item2");
+
+    SegmentedQueue<string, 2> q3;
+    q3.enqueue("Old");
+    q3 = q2; // Copy assignment
+    assert(q3.size() == 4 && q3.peek() == "Item1");
+
+    SegmentedQueue<string, 2> q4 = std::move(q3); // Move constructor
+    assert(q4.size() == 4 && q3.empty());
+    q3.enqueue("Reused");
+    assert(q3.peek() == "Reused");
+
+    q4 = std::move(q1); // Move assignment
+    assert(q4.size() == 3 && q4.peek() == "Item2");
+}
+
+// Test a move-only type
+void test_move_only() {
+    SegmentedQueue<unique_ptr<int>, 2> q;
+    for (int i = 0; i < 5; ++i) q.emplace(new int(i));
+    for (int i = 0; i < 5; ++i) assert(*q.pop() == i);
+    assert(q.empty());
+}
+
+// Slowest single enqueue/dequeue while the queue grows to a few million elements,
+// against ArrayQueue's doubling/halving (timings printed, not asserted: the maximum
+// also catches page faults and preemption, the 99.99th percentile shows the trend)
+void report(const string& what, vector<float>& us) {
+    sort(us.begin(), us.end());
+    cout << "      " << what << ": p99.99 " << us[us.size() * 9999 / 10000] << " us, max " << us.back() << " us" << endl;
+}
+
+template <typename Q>
+void worst_case_latency(const string& name, Q& q, int n) {
+    using Clock = chrono::steady_clock;
+    vector<float> enqueue_us(n), dequeue_us(n);
+    for (int i = 0; i < n; ++i) {
+        auto t0 = Clock::now();
+        q.enqueue(i);
+        enqueue_us[i] = chrono::duration<float, micro>(Clock::now() - t0).count();
+    }
+    for (int i = 0; i < n; ++i) {
+        auto t0 = Clock::now();
+        q.dequeue();
+        dequeue_us[i] = chrono::duration<float, micro>(Clock::now() - t0).count();
+    }
+    cout << "   " << name << endl;
+    report("enqueue", enqueue_us);
+    report("dequeue", dequeue_us);
+}
+
+void test_latency() {
+    const int N = 1 << 22;
+    ArrayQueue<long long> array_queue;
+    SegmentedQueue<long long> segmented_queue;
+    worst_case_latency("ArrayQueue", array_queue, N);
+    worst_case_latency("SegmentedQueue", segmented_queue, N);
+    // Only the last block and the spare remain
+    assert(segmented_queue.empty() && segmented_queue.allocated_size() == 2 * segmented_queue.block_size());
+}
+
+
+int main(void) {
+    cout << "Starting SegmentedQueue Test Suite..." << endl;
+
+    run_test("Basic Operations", test_basic_operations);
+    run_test("Block Allocation and Release", test_blocks);
+    run_test("Copy and Move Semantics", test_copy_move);
+    run_test("Move-only Type", test_move_only);
+    run_test("Worst-case Latency (4M elements)", test_latency);
+
+    return 0;
+}
@@ -0,0 +1,217 @@
+// test_SpillingQueue.cpp
+#include "SpillingQueue.h"
+#include <queue>
+#include <random>
+#include <chrono>
+#include <cassert>
+#include <cstdio>
+#include <csignal>
+#include <sys/resource.h>
+
+using namespace std;
+
+// Wrapper to run a specific test function and catch/display exceptions
+void run_test(const string& test_name, void (*test_func)()) {
+    cout << "\n--- Starting Test: " << test_name << " ---" << endl;
+    try {
+        test_func();
+        cout << "--- Test Passed: " << test_name << " ---" << endl;
+    } catch (const exception& e) {
+        cerr << "--- Test FAILED: " << test_name << " ---" << endl;
+        cerr << "   Exception caught: " << e.what() << endl;
+    } catch (...) {
+        cerr << "--- Test FAILED: " << test_name << " ---" << endl;
+        cerr << "   Unknown error caught." << endl;
+    }
+}
+
+// Test basic Enqueue, Dequeue, and Peek operations (all in memory)
+void test_basic_operations() {
+    SpillingQueue q;
+    assert(q.empty() && q.size() == 0);
+
+    q.enqueue("Alpha");
+    q.enqueue(string("Beta"));
+    assert(q.peek() == "Alpha" && q.size() == 2);
+
+    q.dequeue();
+    assert(q.peek() == "Beta");
+    assert(q.pop() == "Beta");
+    assert(q.empty() && q.spilled_items() == 0 && q.segment_files() == 0);
+
+    q.dequeue(); // Test dequeuing from an empty queue (should print error/no crash)
+    assert(q.empty());
+}
+
+// Random enqueues and dequeues against std::queue with a small budget: the order
+// holds across memory and several segment files, and memory stays within the budget
+void test_spill_order() {
+    const size_t BUDGET = 4096;
+    SpillingQueue q(BUDGET, 16384);
+    queue<string> expected;
+    mt19937 rng(7);
+    int max_files = 0;
+
+    for (int i = 0; i < 200000; ++i) {
+        if (rng() % 3 != 0 || expected.empty()) {
+            string item = to_string(i) + string(rng() % 100, 'a' + i % 26);
+            q.enqueue(item);
+            expected.push(item);
+        } else {
+            assert(q.peek() == expected.front());
+            if (i % 2) q.dequeue(); else assert(q.pop() == expected.front());
+            expected.pop();
+        }
+        assert(q.size() == expected.size());
+        assert(q.memory_bytes() <= BUDGET);
+        max_files = max(max_files, q.segment_files());
+    }
+    assert(q.spilled_items() > 0 && max_files > 1);
+
+    while (!expected.empty()) {
+        assert(q.pop() == expected.front());
+        expected.pop();
+    }
+    assert(q.empty() && q.spilled_items() == 0 && q.spilled_bytes() == 0 && q.segment_files() == 0);
+}
+
+// Items larger than the budget and empty items
+void test_large_items() {
+    SpillingQueue q(1024);
+    string big(100000, 'x');
+    q.enqueue("first");
+    for (int i = 0; i < 3; ++i) {
+        q.enqueue(big);
+        q.enqueue("");
+    }
+    assert(q.spilled_items() > 0);
+    assert(q.pop() == "first");
+    for (int i = 0; i < 3; ++i) {
+        assert(q.pop() == big);
+        assert(q.pop().empty());
+    }
+    assert(q.empty());
+}
+
+// AddressSanitizer keeps freed memory resident for a while, so resident growth is
+// only checked without it
+#if defined(__SANITIZE_ADDRESS__)
+const bool CHECK_RESIDENT = false;
+#else
+const bool CHECK_RESIDENT = true;
+#endif
+
+// Resident memory of the process, from /proc/self/statm
+size_t resident_bytes() {
+    size_t pages = 0, resident = 0;
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (f) {
+        if (fscanf(f, "%zu %zu", &pages, &resident) != 2) resident = 0;
+        fclose(f);
+    }
+    return resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+// 8-byte items cost far more than their 8 bytes (a string object and an array slot
+// each): memory_bytes() counts them and the process stays near the budget
+void test_small_items() {
+    const size_t BUDGET = 4 << 20;
+    const int N = 4000000;
+    size_t rss_before = resident_bytes();
+    size_t max_memory = 0;
+    {
+        SpillingQueue q(BUDGET);
+        for (int i = 0; i < N; ++i) {
+            q.enqueue(string(8, 'a' + i % 26));
+            max_memory = max(max_memory, q.memory_bytes());
+        }
+        size_t rss_growth = resident_bytes() - min(rss_before, resident_bytes());
+        cout << "   " << N << " items, memory " << max_memory / 1024 << " KiB at most, resident growth "
+             << rss_growth / 1024 << " KiB" << endl;
+        assert(max_memory <= BUDGET);
+        assert(!CHECK_RESIDENT || rss_growth <= 2 * BUDGET);
+
+        for (int i = 0; i < N; ++i) {
+            assert(q.pop() == string(8, 'a' + i % 26));
+            max_memory = max(max_memory, q.memory_bytes());
+        }
+        assert(q.empty() && max_memory <= BUDGET);
+    }
+}
+
+// A write that fails (the file size limit stands in for a full disk) throws from the
+// enqueue that spilled, and leaves every item accepted before it queued, in order
+void test_failed_write() {
+    struct rlimit saved;
+    getrlimit(RLIMIT_FSIZE, &saved);
+    struct rlimit limit = saved;
+    limit.rlim_cur = 100000;
+    signal(SIGXFSZ, SIG_IGN); // write() fails with EFBIG instead of killing the process
+    setrlimit(RLIMIT_FSIZE, &limit);
+
+    SpillingQueue q(4096);
+    uint64_t accepted = 0;
+    bool threw = false;
+    try {
+        for (; accepted < 1000000; ++accepted) {
+            q.enqueue(to_string(accepted) + string(accepted % 50, 'f'));
+        }
+    } catch (const runtime_error& e) {
+        threw = true;
+        cout << "   write failed after " << accepted << " items: " << e.what() << endl;
+    }
+    setrlimit(RLIMIT_FSIZE, &saved);
+    signal(SIGXFSZ, SIG_DFL);
+    assert(threw && q.size() == accepted);
+
+    // Writing works again once there is room: the queue carries on
+    q.enqueue("after");
+    for (uint64_t i = 0; i < accepted; ++i) {
+        assert(q.pop() == to_string(i) + string(i % 50, 'f'));
+    }
+    assert(q.pop() == "after" && q.empty() && q.segment_files() == 0);
+}
+
+// A backlog much larger than the budget: slowest enqueue and throughput
+// (timings printed, not asserted)
+void test_backlog() {
+    const int N = 2000000;
+    const string item(100, 'p');
+    SpillingQueue q(1 << 20, 64 << 20);
+    using Clock = chrono::steady_clock;
+    float max_us = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < N; ++i) {
+        auto t0 = Clock::now();
+        q.enqueue(item);
+        max_us = max(max_us, chrono::duration<float, micro>(Clock::now() - t0).count());
+    }
+    double enqueue_s = chrono::duration<double>(Clock::now() - start).count();
+    assert(q.memory_bytes() <= (1 << 20) && q.spilled_bytes() > 100ull * N / 2);
+    cout << "   " << N << " items, " << q.spilled_bytes() / (1 << 20) << " MiB spilled in "
+         << q.segment_files() << " files, memory " << q.memory_bytes() / 1024 << " KiB" << endl;
+
+    start = Clock::now();
+    for (int i = 0; i < N; ++i) {
+        assert(q.peek().size() == item.size());
+        q.dequeue();
+    }
+    double dequeue_s = chrono::duration<double>(Clock::now() - start).count();
+    assert(q.empty() && q.segment_files() == 0);
+    cout << "   enqueue " << N / enqueue_s / 1e6 << " M/s (slowest " << max_us << " us), dequeue "
+         << N / dequeue_s / 1e6 << " M/s" << endl;
+}
+
+
+int main(void) {
+    cout << "Starting SpillingQueue Test Suite..." << endl;
+
+    run_test("Basic Operations", test_basic_operations);
+    run_test("Spilled FIFO Order", test_spill_order);
+    run_test("Large and Empty Items", test_large_items);
+    run_test("Small Items within the Budget", test_small_items);
+    run_test("Failed Write Keeps Every Item", test_failed_write);
+    run_test("Backlog Larger than the Budget (200 MB)", test_backlog);
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+// test_StringArenaQueue.cpp
+#include "StringArenaQueue.h"
+#include <queue>
+#include <random>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cassert>
+
+using namespace std;
+
+// Allocation counter: every operator new in this test goes through here
+// (GCC's mismatched-new-delete check misfires once std::allocator calls are inlined)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+atomic<long> g_allocations(0);
+void* operator new(size_t size) {
+    g_allocations++;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// Wrapper to run a specific test function and catch/display exceptions
+void run_test(const string& test_name, void (*test_func)()) {
+    cout << "\n--- Starting Test: " << test_name << " ---" << endl;
+    try {
+        test_func();
+        cout << "--- Test Passed: " << test_name << " ---" << endl;
+    } catch (const exception& e) {
+        cerr << "--- Test FAILED: " << test_name << " ---" << endl;
+        cerr << "   Exception caught: " << e.what() << endl;
+    } catch (...) {
+        cerr << "--- Test FAILED: " << test_name << " ---" << endl;
+        cerr << "   Unknown error caught." << endl;
+    }
+}
+
+// Test basic Enqueue, Dequeue, and Peek operations
+void test_basic_operations() {
+    StringArenaQueue q;
+    assert(q.empty() && q.size() == 0);
+
+    q.enqueue("Alpha");
+    q.enqueue(string("Beta"));
+    q.enqueue("");
+    assert(q.peek() == "Alpha" && q.size() == 3 && q.arena_used() == 9);
+
+    q.dequeue();
+    assert(q.peek() == "Beta");
+    assert(q.pop() == "Beta");
+    assert(q.peek().empty() && q.size() == 1);
+    q.dequeue();
+    assert(q.empty() && q.arena_used() == 0);
+
+    q.dequeue(); // Test dequeuing from an empty queue (should print error/no crash)
+    assert(q.empty());
+}
+
+// Test that items restart at offset 0 when they do not fit at the end, reusing freed bytes
+void test_wrap_around() {
+    StringArenaQueue q(16);
+    q.enqueue("0123456789"); // [0, 10)
+    q.enqueue("abcd");       // [10, 14)
+    q.dequeue();             // frees [0, 10)
+    q.enqueue("WXYZ");       // does not fit in [14, 16): goes to [0, 4)
+    assert(q.arena_capacity() == 16); // no growth needed
+    assert(q.peek() == "abcd");
+    q.dequeue();             // head skips the gap to offset 0
+    assert(q.peek() == "WXYZ");
+    q.enqueue("12345");      // [4, 9)
+    q.enqueue("678");        // [9, 12)
+    assert(q.arena_capacity() == 16);
+    assert(q.pop() == "WXYZ" && q.pop() == "12345" && q.pop() == "678" && q.empty());
+}
+
+// Test growth: live bytes are compacted into a larger arena
+void test_growth() {
+    StringArenaQueue q(8);
+    q.enqueue("abcdef");
+    q.dequeue();
+    q.enqueue("ghij");       // [6, 8) too short: wraps to [0, 4)
+    q.enqueue("klmnopqrstuvwxyz"); // needs growth
+    assert(q.arena_capacity() >= 20);
+    q.enqueue(string(1000, 'L')); // larger than double the arena
+    assert(q.pop() == "ghij" && q.pop() == "klmnopqrstuvwxyz" && q.pop() == string(1000, 'L'));
+}
+
+// Random operations against std::queue<string>
+void test_random_against_std_queue() {
+    mt19937 rng(19);
+    StringArenaQueue q(64);
+    queue<string> reference;
+    for (int step = 0; step < 200000; ++step) {
+        if (reference.empty() || rng() % 100 < 52) {
+            string s(rng() % 40, char('a' + rng() % 26));
+            q.enqueue(s);
+            reference.push(s);
+        } else {
+            assert(q.peek() == reference.front());
+            q.dequeue();
+            reference.pop();
+        }
+        assert(q.size() == (int)reference.size());
+    }
+    cout << "   " << q.size() << " items left, arena " << q.arena_capacity() << " bytes" << endl;
+}
+
+// 300-byte messages: heap allocations and time per enqueue+peek+dequeue
+// Returns the number of allocations in the timed loop
+template <typename Q, typename Peek>
+long measure(const string& name, Q& q, Peek peek_copy) {
+    const int N = 1000000, BACKLOG = 1000;
+    string message(300, 'm');
+    for (int i = 0; i < BACKLOG; ++i) q.enqueue(message);
+
+    long allocations = g_allocations;
+    size_t checksum = 0;
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < N; ++i) {
+        message[i % 300] = char('a' + i % 26);
+        q.enqueue(message);
+        checksum += peek_copy(q);
+        q.dequeue();
+    }
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / N;
+    allocations = g_allocations - allocations;
+    cout << "   " << name << ": " << (double)allocations / N << " allocations/op, " << ns
+         << " ns/op (checksum " << checksum << ")" << endl;
+    return allocations;
+}
+
+void test_allocations() {
+    ArrayQueue<string> array_queue(2048);
+    measure("ArrayQueue<string>", array_queue, [](ArrayQueue<string>& q) { return q.peek().size(); });
+    StringArenaQueue arena_queue(1 << 20, 2048);
+    long allocations = measure("StringArenaQueue  ", arena_queue, [](StringArenaQueue& q) { return q.peek().size(); });
+    assert(allocations == 0); // none at all once the arena is large enough
+}
+
+
+int main(void) {
+    cout << "Starting StringArenaQueue Test Suite..." << endl;
+
+    run_test("Basic Operations", test_basic_operations);
+    run_test("Wrap-around and Reclamation", test_wrap_around);
+    run_test("Arena Growth", test_growth);
+    run_test("Random Operations vs std::queue", test_random_against_std_queue);
+    run_test("Heap Allocations (300-byte messages)", test_allocations);
+
+    return 0;
+}
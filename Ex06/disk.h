@@ -16,6 +16,10 @@ public:
     Disk(); 
     Disk(const Disk& other);
 
+    // Accessors
+    Point center() const { return center_; }
+    float radius() const { return radius_; }
+
     // Overrides
     std::string get_name() const override;
     float compute_area() const override;
@@ -17,6 +17,9 @@ public:
     Polygon() : N_(0) {}
     Polygon(const Polygon& other);
 
+    // Accessors (no vertices if the polygon is invalid, i.e. N < 3)
+    const std::vector<Point>& vertices() const { return vertices_; }
+
     // Overrides
     std::string get_name() const override;
     float compute_area() const override;
@@ -0,0 +1,166 @@
+#include "shape_batch.h"
+#include "disk.h"
+#include "polygon.h"
+#include <cmath>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846f
+#endif
+
+namespace {
+
+const float PI = (float)M_PI;
+
+// Area of one polygon from the flattened arrays (Shoelace Formula, same order as Polygon)
+float polygon_area(const float* x, const float* y, int begin, int end) {
+    int N = end - begin;
+    if (N < 3) return 0.0f;
+
+    float sum = 0.0f;
+    for (int i = 0; i < N; ++i) {
+        int k = begin + i;
+        int next = begin + (i + 1) % N; // Wrap around to P_0
+        sum += (x[k] * y[next] - y[k] * x[next]);
+    }
+    return std::abs(sum / 2.0f);
+}
+
+#if defined(__AVX2__)
+// Stores the areas of shapes index[0..7]: one store if their numbers are consecutive
+void store8(float* out, const int* index, __m256 areas) {
+    if (index[7] - index[0] == 7) {
+        _mm256_storeu_ps(out + index[0], areas);
+        return;
+    }
+    float a[8];
+    _mm256_storeu_ps(a, areas);
+    for (int k = 0; k < 8; ++k) out[index[k]] = a[k];
+}
+#endif
+
+void disk_areas(const float* r, const int* index, int n, float* out) {
+    int i = 0;
+#if defined(__AVX2__)
+    const __m256 pi = _mm256_set1_ps(PI);
+    for (; i + 8 <= n; i += 8) {
+        __m256 radius = _mm256_loadu_ps(r + i);
+        store8(out, index + i, _mm256_mul_ps(_mm256_mul_ps(pi, radius), radius));
+    }
+#endif
+    for (; i < n; ++i) out[index[i]] = PI * r[i] * r[i];
+}
+
+// 8 polygons at a time, one per lane: step j gathers vertex j and its successor
+// of every polygon that has more than j vertices, for as many steps as the
+// largest of the 8 has vertices
+void polygon_areas(const float* x, const float* y, const int* offset, const int* index, int n, float* out) {
+    int i = 0;
+#if defined(__AVX2__)
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    for (; i + 8 <= n; i += 8) {
+        __m256i begin = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offset + i));
+        __m256i end = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offset + i + 1));
+        __m256i count = _mm256_sub_epi32(end, begin);
+
+        int max_count = 0;
+        for (int k = 0; k < 8; ++k) max_count = std::max(max_count, offset[i + k + 1] - offset[i + k]);
+
+        __m256 sum = _mm256_setzero_ps();
+        for (int j = 0; j < max_count; ++j) {
+            __m256i active = _mm256_cmpgt_epi32(count, _mm256_set1_epi32(j));
+            __m256i has_next = _mm256_cmpgt_epi32(count, _mm256_set1_epi32(j + 1));
+            __m256i k = _mm256_add_epi32(begin, _mm256_set1_epi32(j));
+            __m256i next = _mm256_blendv_epi8(begin, _mm256_add_epi32(k, _mm256_set1_epi32(1)), has_next);
+            __m256 mask = _mm256_castsi256_ps(active);
+
+            // Inactive lanes gather nothing and add 0
+            __m256 xk = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), x, k, mask, 4);
+            __m256 yk = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), y, k, mask, 4);
+            __m256 xn = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), x, next, mask, 4);
+            __m256 yn = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), y, next, mask, 4);
+            sum = _mm256_add_ps(sum, _mm256_sub_ps(_mm256_mul_ps(xk, yn), _mm256_mul_ps(yk, xn)));
+        }
+        // Polygons with fewer than 3 vertices have none stored, so their sum is 0
+        store8(out, index + i, _mm256_andnot_ps(sign, _mm256_mul_ps(sum, half)));
+    }
+#endif
+    for (; i < n; ++i) out[index[i]] = polygon_area(x, y, offset[i], offset[i + 1]);
+}
+
+} // namespace
+
+ShapeBatch::ShapeBatch()
+    : size_(0), offset_(1, 0) {}
+
+int ShapeBatch::add_disk(Point center, float radius) {
+    disk_x_.push_back(center.x);
+    disk_y_.push_back(center.y);
+    disk_r_.push_back(radius);
+    disk_index_.push_back(size_);
+    return size_++;
+}
+
+int ShapeBatch::add_polygon(int N, const Point* points) {
+    // Same validation as Polygon: an invalid polygon keeps no vertices
+    if (N >= 3 && points != nullptr) {
+        for (int i = 0; i < N; ++i) {
+            vertex_x_.push_back(points[i].x);
+            vertex_y_.push_back(points[i].y);
+        }
+    }
+    offset_.push_back((int)vertex_x_.size());
+    polygon_index_.push_back(size_);
+    return size_++;
+}
+
+int ShapeBatch::add(const Shape& shape) {
+    if (const Disk* d = dynamic_cast<const Disk*>(&shape)) {
+        return add_disk(d->center(), d->radius());
+    }
+    if (const Polygon* p = dynamic_cast<const Polygon*>(&shape)) {
+        return add_polygon((int)p->vertices().size(), p->vertices().data());
+    }
+    others_.emplace_back(shape.clone());
+    other_index_.push_back(size_);
+    return size_++;
+}
+
+void ShapeBatch::reserve(int disks, int polygons, int vertices) {
+    disk_x_.reserve(disks);
+    disk_y_.reserve(disks);
+    disk_r_.reserve(disks);
+    disk_index_.reserve(disks);
+    vertex_x_.reserve(vertices);
+    vertex_y_.reserve(vertices);
+    offset_.reserve(polygons + 1);
+    polygon_index_.reserve(polygons);
+}
+
+// Removes all shapes (the arrays keep their capacity)
+void ShapeBatch::clear() {
+    size_ = 0;
+    disk_x_.clear();
+    disk_y_.clear();
+    disk_r_.clear();
+    disk_index_.clear();
+    vertex_x_.clear();
+    vertex_y_.clear();
+    offset_.assign(1, 0);
+    polygon_index_.clear();
+    others_.clear();
+    other_index_.clear();
+}
+
+void ShapeBatch::compute_areas(float* out) const {
+    disk_areas(disk_r_.data(), disk_index_.data(), disk_count(), out);
+    polygon_areas(vertex_x_.data(), vertex_y_.data(), offset_.data(), polygon_index_.data(), polygon_count(), out);
+    for (size_t i = 0; i < others_.size(); ++i) {
+        out[other_index_[i]] = others_[i]->compute_area();
+    }
+}
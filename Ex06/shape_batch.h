@@ -0,0 +1,60 @@
+#ifndef SHAPE_BATCH_H
+#define SHAPE_BATCH_H
+
+#include "shape.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Container of many shapes stored by kind, for computing all areas at once.
+ *
+ * Disks are kept as separate arrays of centers and radii (structure of arrays).
+ * Polygon vertices are flattened into one x array and one y array, and an offset
+ * table marks where each polygon starts. compute_areas() then runs one loop per
+ * kind over contiguous arrays (8 shapes at a time with AVX2 when compiled with
+ * -mavx2) instead of one virtual call and one heap object per shape.
+ *
+ * Shapes are numbered in the order they were added. Shapes of other kinds are
+ * cloned and their areas computed through the Shape interface.
+ * The total number of polygon vertices must stay below 2^31.
+ */
+class ShapeBatch {
+private:
+    int size_; // Number of shapes of all kinds
+
+    // Disks: center, radius, and the shape's number
+    std::vector<float> disk_x_;
+    std::vector<float> disk_y_;
+    std::vector<float> disk_r_;
+    std::vector<int> disk_index_;
+
+    // Polygons: vertices of polygon i are [offset_[i], offset_[i + 1]) in vertex_x_/vertex_y_
+    std::vector<float> vertex_x_;
+    std::vector<float> vertex_y_;
+    std::vector<int> offset_;
+    std::vector<int> polygon_index_;
+
+    // Shapes of other kinds
+    std::vector<std::unique_ptr<Shape>> others_;
+    std::vector<int> other_index_;
+
+public:
+    ShapeBatch();
+
+    // Each add returns the shape's number (its position in compute_areas' output)
+    int add_disk(Point center, float radius);
+    int add_polygon(int N, const Point* points); // N < 3 gives an invalid polygon (area 0)
+    int add(const Shape& shape);
+
+    void reserve(int disks, int polygons, int vertices);
+    void clear();
+
+    int size() const { return size_; }
+    int disk_count() const { return (int)disk_r_.size(); }
+    int polygon_count() const { return (int)polygon_index_.size(); }
+
+    // Writes the area of shape i to out[i], for all size() shapes
+    void compute_areas(float* out) const;
+};
+
+#endif // SHAPE_BATCH_H
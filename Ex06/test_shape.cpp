@@ -4,6 +4,11 @@
 #include "shape.h"
 #include "disk.h"
 #include "polygon.h"
+#include "shape_batch.h"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
 
 void test_disk_functionality() {
     std::cout << "--- Disk Test ---" << std::endl;
@@ -64,10 +69,77 @@ void test_dynamic_polymorphism() {
     std::cout << "---------------------------------" << std::endl;
 }
 
+void test_shape_batch() {
+    std::cout << "--- ShapeBatch Test ---" << std::endl;
+
+    ShapeBatch batch;
+    Point square_points[] = { Point(0.0f, 0.0f), Point(4.0f, 0.0f), Point(4.0f, 4.0f), Point(0.0f, 4.0f) };
+    Point triangle_points[] = { Point(0.0f, 0.0f), Point(4.0f, 0.0f), Point(2.0f, 3.0f) };
+    batch.add_disk(Point(1.0f, 2.0f), 5.0f);
+    batch.add_polygon(4, square_points);
+    batch.add(Polygon(3, triangle_points));
+    batch.add_polygon(2, square_points); // Invalid (N < 3)
+    batch.add(Disk(Point(0.0f, 0.0f), 10.0f));
+
+    std::vector<float> areas(batch.size());
+    batch.compute_areas(areas.data());
+    std::cout << "Batch Areas (Disk R=5, Square, Triangle, Invalid, Disk R=10):";
+    for (float a : areas) std::cout << " " << a;
+    std::cout << std::endl;
+
+    // Random scene: batch against one virtual call per Shape*
+    const int N = 1000000;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coord(-100.0f, 100.0f);
+    std::vector<std::unique_ptr<Shape>> shapes;
+    std::vector<float> magnitude(N, 0.0f); // half the sum of |shoelace terms| of each polygon
+    ShapeBatch scene;
+    Point points[12];
+    for (int i = 0; i < N; ++i) {
+        if (rng() % 2) {
+            shapes.emplace_back(new Disk(Point(coord(rng), coord(rng)), std::abs(coord(rng))));
+        } else {
+            int n = 3 + rng() % 10;
+            for (int k = 0; k < n; ++k) points[k] = Point(coord(rng), coord(rng));
+            for (int k = 0; k < n; ++k) {
+                const Point& a = points[k];
+                const Point& b = points[(k + 1) % n];
+                magnitude[i] += 0.5f * (std::abs(a.x * b.y) + std::abs(a.y * b.x));
+            }
+            shapes.emplace_back(new Polygon(n, points));
+        }
+        scene.add(*shapes.back());
+    }
+
+    std::vector<float> expected(N), batch_areas(N);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < N; ++i) expected[i] = shapes[i]->compute_area();
+    auto t1 = std::chrono::steady_clock::now();
+    scene.compute_areas(batch_areas.data());
+    auto t2 = std::chrono::steady_clock::now();
+
+    // Random polygons self-intersect, so the shoelace sum can cancel down to an area far
+    // smaller than its terms: rounding differences (e.g. fused multiply-adds in only one
+    // of the two loops) are measured against the size of the terms, not of the area
+    float max_error = 0.0f;
+    for (int i = 0; i < N; ++i) {
+        float scale = std::max({expected[i], magnitude[i], 1.0f});
+        float error = std::abs(batch_areas[i] - expected[i]) / scale;
+        max_error = std::max(max_error, error);
+    }
+    std::cout << "Scene: " << scene.disk_count() << " disks, " << scene.polygon_count() << " polygons" << std::endl;
+    std::cout << "Max relative difference to compute_area(): " << max_error
+              << (max_error < 1e-5f ? " [OK]" : " [FAIL]") << std::endl;
+    std::cout << "Virtual calls: " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms, "
+              << "ShapeBatch: " << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms" << std::endl;
+    std::cout << "-----------------------" << std::endl;
+}
+
 int main() {
     // Run all tests
     test_disk_functionality();
     test_polygon_functionality();
     test_dynamic_polymorphism();
+    test_shape_batch();
     return 0;
 }